@@ -0,0 +1,348 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "AdaptorOCL/CompilationCache.hpp"
+#include "Compiler/CISACodeGen/Platform.hpp"
+#include "common/igc_regkeys.hpp"
+
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "version.h"
+
+using namespace llvm;
+
+namespace TC
+{
+
+extern std::unordered_map<uint32_t, uint64_t> UnpackSpecConstants(
+    const uint32_t* pSpecConstantsIds,
+    const uint64_t* pSpecConstantsValues,
+    uint32_t size);
+
+extern bool TranslateBuild(
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    TB_DATA_FORMAT inputDataFormatTemp,
+    const IGC::CPlatform& IGCPlatform,
+    float profilingTimerResolution);
+
+namespace
+{
+    constexpr uint32_t EntryMagic = 0x43434749; // "IGCC"
+    constexpr uint32_t EntryVersion = 1;
+    constexpr const char* EntryExtension = ".igccache";
+
+    struct EntryHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t OutputSize;
+        uint32_t DebugDataSize;
+        uint32_t ErrorStringSize;
+    };
+
+    class KeyHasher
+    {
+    public:
+        template <typename T>
+        void addPod(const T& Value)
+        {
+            m_Hasher.update(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(&Value), sizeof(T)));
+        }
+
+        // Length-prefixed so that adjacent fields can't alias each other.
+        void addBytes(const void* Data, size_t Size)
+        {
+            addPod<uint64_t>(Size);
+            if (Size)
+                m_Hasher.update(ArrayRef<uint8_t>(static_cast<const uint8_t*>(Data), Size));
+        }
+
+        void addString(StringRef Str) { addBytes(Str.data(), Str.size()); }
+
+        std::string finalHex() { return toHex(m_Hasher.final(), /*LowerCase=*/true); }
+
+    private:
+        SHA1 m_Hasher;
+    };
+
+    char* copyBuffer(const char* Data, uint32_t Size)
+    {
+        if (Size == 0)
+            return nullptr;
+        char* Buffer = new char[Size];
+        std::memcpy(Buffer, Data, Size);
+        return Buffer;
+    }
+} // namespace
+
+std::unique_ptr<CompilationCache> CompilationCache::Create(
+    const STB_TranslateInputArgs& InputArgs,
+    const IGC::CPlatform& Platform,
+    TB_DATA_FORMAT InputFormat,
+    TB_DATA_FORMAT OutputFormat,
+    float ProfilingTimerResolution)
+{
+#ifndef IGC_REVISION
+    // Without a revision, outputs of different compiler builds can't be
+    // told apart.
+    return nullptr;
+#else
+    std::string Dir = IGC_GET_REGKEYSTRING(OCLCompilationCacheDir);
+    if (Dir.empty())
+        return nullptr;
+
+    // Outputs that also produce files or feed instrumentation have to be
+    // compiled every time.
+    if (InputArgs.GTPinInput || InputArgs.pTracingOptions ||
+        InputArgs.CompileTimeStatisticsEnable ||
+        IGC_IS_FLAG_ENABLED(ShaderDumpEnable) ||
+        IGC_IS_FLAG_ENABLED(ShaderOverride) ||
+        IGC_IS_FLAG_ENABLED(DumpOCLProgramInfo) ||
+        IGC_IS_FLAG_ENABLED(DumpTraceEvents))
+        return nullptr;
+
+    if (sys::fs::create_directories(Dir))
+        return nullptr;
+
+    KeyHasher Key;
+    Key.addString(IGC_REVISION);
+    Key.addPod(InputFormat);
+    Key.addPod(OutputFormat);
+    Key.addPod(ProfilingTimerResolution);
+    // Raw bytes of the platform description. Padding only ever turns a hit
+    // into a miss.
+    Key.addPod(Platform.getPlatformInfo());
+    Key.addPod(Platform.getSkuTable());
+    Key.addPod(Platform.getWATable());
+    Key.addPod(Platform.GetGTSystemInfo());
+
+    Key.addBytes(InputArgs.pInput, InputArgs.InputSize);
+    Key.addBytes(InputArgs.pOptions, InputArgs.OptionsSize);
+    Key.addBytes(InputArgs.pInternalOptions, InputArgs.InternalOptionsSize);
+
+    auto SpecConstants = UnpackSpecConstants(
+        InputArgs.pSpecConstantsIds, InputArgs.pSpecConstantsValues, InputArgs.SpecConstantsSize);
+    std::vector<std::pair<uint32_t, uint64_t>> SortedSpecConstants(SpecConstants.begin(), SpecConstants.end());
+    std::sort(SortedSpecConstants.begin(), SortedSpecConstants.end());
+    Key.addPod<uint64_t>(SortedSpecConstants.size());
+    for (const auto& SC : SortedSpecConstants)
+    {
+        Key.addPod(SC.first);
+        Key.addPod(SC.second);
+    }
+
+    Key.addPod(InputArgs.NumVISAAsmsToLink);
+    for (uint32_t i = 0; i < InputArgs.NumVISAAsmsToLink; ++i)
+        Key.addString(InputArgs.pVISAAsmToLinkArray[i]);
+    Key.addPod(InputArgs.NumDirectCallFunctions);
+    for (uint32_t i = 0; i < InputArgs.NumDirectCallFunctions; ++i)
+        Key.addString(InputArgs.pDirectCallFunctions[i]);
+
+    // The keys set explicitly, with string values in full. The keys of the
+    // cache itself don't change the output.
+    const SRegKeyVariableMetaData* pRegKeyVariable = (const SRegKeyVariableMetaData*)&g_RegKeyList;
+    for (unsigned i = 0; i < NUM_REGKEY_ENTRIES; i++)
+    {
+        const SRegKeyVariableMetaData& RegKey = GetRegKey(pRegKeyVariable[i]);
+        if (!RegKey.m_isSetToNonDefaultValue)
+            continue;
+        StringRef Name = RegKey.GetName();
+        if (Name == "OCLCompilationCacheDir" ||
+            Name == "OCLCompilationCacheMaxSizeMB" ||
+            Name == "PrintOCLCompilationCache")
+            continue;
+        Key.addString(Name);
+        Key.addPod(RegKey.m_Value);
+        Key.addString(StringRef(RegKey.m_string, strnlen(RegKey.m_string, sizeof(RegKey.m_string))));
+    }
+
+    SmallString<256> EntryPath(Dir);
+    sys::path::append(EntryPath, Key.finalHex() + EntryExtension);
+
+    uint64_t MaxSize = uint64_t(IGC_GET_FLAG_VALUE(OCLCompilationCacheMaxSizeMB)) << 20;
+    return std::unique_ptr<CompilationCache>(
+        new CompilationCache(std::move(Dir), EntryPath.str().str(), MaxSize));
+#endif
+}
+
+bool CompilationCache::TranslateBuild(
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    TB_DATA_FORMAT InputFormat,
+    TB_DATA_FORMAT OutputFormat,
+    const IGC::CPlatform& Platform,
+    float ProfilingTimerResolution)
+{
+    auto Cache = Create(*pInputArgs, Platform, InputFormat, OutputFormat, ProfilingTimerResolution);
+    if (Cache)
+    {
+        bool Hit = Cache->Load(*pOutputArgs);
+        if (IGC_IS_FLAG_ENABLED(PrintOCLCompilationCache))
+        {
+            errs() << "OCL compilation cache " << (Hit ? "hit: " : "miss: ")
+                   << sys::path::filename(Cache->m_EntryPath) << "\n";
+        }
+        if (Hit)
+        {
+            return true;
+        }
+    }
+
+    bool success = TC::TranslateBuild(pInputArgs, pOutputArgs, InputFormat, Platform, ProfilingTimerResolution);
+    if (success && Cache)
+    {
+        Cache->Store(*pOutputArgs);
+    }
+    return success;
+}
+
+bool CompilationCache::Load(STB_TranslateOutputArgs& OutputArgs) const
+{
+    auto BufferOrErr = MemoryBuffer::getFile(m_EntryPath);
+    if (!BufferOrErr)
+        return false;
+
+    const MemoryBuffer& Buffer = **BufferOrErr;
+    EntryHeader Header;
+    if (Buffer.getBufferSize() < sizeof(Header))
+        return false;
+    std::memcpy(&Header, Buffer.getBufferStart(), sizeof(Header));
+    if (Header.Magic != EntryMagic || Header.Version != EntryVersion ||
+        Buffer.getBufferSize() != sizeof(Header) + uint64_t(Header.OutputSize) +
+            Header.DebugDataSize + Header.ErrorStringSize)
+        return false;
+
+    const char* Data = Buffer.getBufferStart() + sizeof(Header);
+    OutputArgs.pOutput = copyBuffer(Data, Header.OutputSize);
+    OutputArgs.OutputSize = Header.OutputSize;
+    Data += Header.OutputSize;
+    OutputArgs.pDebugData = copyBuffer(Data, Header.DebugDataSize);
+    OutputArgs.DebugDataSize = Header.DebugDataSize;
+    Data += Header.DebugDataSize;
+    OutputArgs.pErrorString = copyBuffer(Data, Header.ErrorStringSize);
+    OutputArgs.ErrorStringSize = Header.ErrorStringSize;
+
+    // Refresh the modification time, it is what eviction orders entries by.
+    int FD;
+    if (!sys::fs::openFileForReadWrite(m_EntryPath, FD, sys::fs::CD_OpenExisting, sys::fs::OF_None))
+    {
+        sys::fs::setLastAccessAndModificationTime(FD, std::chrono::system_clock::now());
+        sys::Process::SafelyCloseFileDescriptor(FD);
+    }
+    return true;
+}
+
+void CompilationCache::Store(const STB_TranslateOutputArgs& OutputArgs) const
+{
+    EntryHeader Header;
+    Header.Magic = EntryMagic;
+    Header.Version = EntryVersion;
+    Header.OutputSize = OutputArgs.OutputSize;
+    Header.DebugDataSize = OutputArgs.DebugDataSize;
+    Header.ErrorStringSize = OutputArgs.ErrorStringSize;
+
+    // Write to a private file first and rename it over the entry, so that
+    // readers never see a partially written one.
+    SmallString<256> TempPath;
+    int FD;
+    if (sys::fs::createUniqueFile(m_EntryPath + ".tmp-%%%%%%%%", FD, TempPath))
+        return;
+    {
+        raw_fd_ostream OS(FD, /*shouldClose=*/true);
+        OS.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+        if (OutputArgs.OutputSize)
+            OS.write(OutputArgs.pOutput, OutputArgs.OutputSize);
+        if (OutputArgs.DebugDataSize)
+            OS.write(OutputArgs.pDebugData, OutputArgs.DebugDataSize);
+        if (OutputArgs.ErrorStringSize)
+            OS.write(OutputArgs.pErrorString, OutputArgs.ErrorStringSize);
+        OS.close();
+        if (OS.has_error())
+        {
+            OS.clear_error();
+            sys::fs::remove(TempPath);
+            return;
+        }
+    }
+    if (sys::fs::rename(TempPath, m_EntryPath))
+    {
+        sys::fs::remove(TempPath);
+        return;
+    }
+
+    Evict();
+}
+
+void CompilationCache::Evict() const
+{
+    if (m_MaxSize == 0)
+        return;
+
+    // Only one process trims the directory at a time; the others just skip
+    // it, the owner sees their entries too.
+    SmallString<256> LockPath(m_Dir);
+    sys::path::append(LockPath, "evict");
+    LockFileManager Lock(LockPath);
+    if (Lock.getState() != LockFileManager::LFS_Owned)
+        return;
+
+    struct Entry
+    {
+        std::string Path;
+        sys::TimePoint<> LastUse;
+        uint64_t Size;
+    };
+    std::vector<Entry> Entries;
+    uint64_t TotalSize = 0;
+
+    std::error_code EC;
+    for (sys::fs::directory_iterator It(m_Dir, EC), End; It != End && !EC; It.increment(EC))
+    {
+        if (sys::path::extension(It->path()) != EntryExtension)
+            continue;
+        sys::fs::file_status Status;
+        if (sys::fs::status(It->path(), Status) || Status.type() != sys::fs::file_type::regular_file)
+            continue;
+        Entries.push_back({ It->path(), Status.getLastModificationTime(), Status.getSize() });
+        TotalSize += Status.getSize();
+    }
+    if (TotalSize <= m_MaxSize)
+        return;
+
+    // Trim a bit below the limit, so that once the cache is full entries are
+    // not deleted one at a time on every store.
+    uint64_t TargetSize = m_MaxSize - m_MaxSize / 10;
+    std::sort(Entries.begin(), Entries.end(),
+        [](const Entry& LHS, const Entry& RHS) { return LHS.LastUse < RHS.LastUse; });
+    for (const Entry& E : Entries)
+    {
+        if (TotalSize <= TargetSize)
+            break;
+        if (!sys::fs::remove(E.Path))
+            TotalSize -= E.Size;
+    }
+}
+
+} // namespace TC
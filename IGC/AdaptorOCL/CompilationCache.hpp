@@ -0,0 +1,75 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "AdaptorOCL/OCL/TB/igc_tb.h"
+
+#include <memory>
+#include <string>
+
+namespace IGC
+{
+    class CPlatform;
+}
+
+namespace TC
+{
+    /// Persistent, content-addressed cache of translation block outputs.
+    ///
+    /// An entry is keyed by a SHA-1 of everything the output depends on:
+    /// the input module, API and internal options, spec constants, the
+    /// platform description, the regkeys set explicitly and the IGC revision.
+    /// The cache lives in the directory given by OCLCompilationCacheDir and
+    /// may be shared by any number of processes: entries are published by
+    /// an atomic rename, and eviction of the least recently used entries,
+    /// once the directory grows past OCLCompilationCacheMaxSizeMB, is done
+    /// by whichever process holds the directory lock.
+    class CompilationCache
+    {
+    public:
+        /// Returns nullptr if the cache is disabled or if this translation
+        /// has side effects (dumps, GTPin, tracing) that a cached output
+        /// would skip.
+        static std::unique_ptr<CompilationCache> Create(
+            const STB_TranslateInputArgs& InputArgs,
+            const IGC::CPlatform& Platform,
+            TB_DATA_FORMAT InputFormat,
+            TB_DATA_FORMAT OutputFormat,
+            float ProfilingTimerResolution);
+
+        /// TranslateBuild through the cache: the output is taken from the
+        /// cache if it is there, and added to it after a successful build
+        /// otherwise. Used by both the translation block and the CIF
+        /// translation context.
+        static bool TranslateBuild(
+            const STB_TranslateInputArgs* pInputArgs,
+            STB_TranslateOutputArgs* pOutputArgs,
+            TB_DATA_FORMAT InputFormat,
+            TB_DATA_FORMAT OutputFormat,
+            const IGC::CPlatform& Platform,
+            float ProfilingTimerResolution);
+
+        /// Fills OutputArgs from the cache. Buffers are allocated the same
+        /// way TranslateBuild allocates them.
+        bool Load(STB_TranslateOutputArgs& OutputArgs) const;
+
+        /// Adds the output of a successful translation to the cache.
+        void Store(const STB_TranslateOutputArgs& OutputArgs) const;
+
+    private:
+        CompilationCache(std::string Dir, std::string EntryPath, uint64_t MaxSize)
+            : m_Dir(std::move(Dir)), m_EntryPath(std::move(EntryPath)), m_MaxSize(MaxSize) {}
+
+        void Evict() const;
+
+        std::string m_Dir;
+        std::string m_EntryPath;
+        uint64_t m_MaxSize;
+    };
+} // namespace TC
@@ -107,9 +107,12 @@ public:
     void CreateKernelBinaries();
 
     /// getZEBinary - create and get ZE Binary
+    /// The binary is written straight into programBinary, allocated with the
+    /// exact size of the binary
     /// if spv and spvSize are given, a .spv section will be created in the output ZEBinary
     bool GetZEBinary(
-        llvm::raw_pwrite_stream& programBinary,
+        std::unique_ptr<char[]>& programBinary,
+        size_t& programBinarySize,
         unsigned pointerSizeInBytes,
         const char* spv,          uint32_t spvSize,
         const char* metrics,      uint32_t metricsSize,
@@ -895,12 +895,22 @@ void ZEBinaryBuilder::getBinaryObject(llvm::raw_pwrite_stream& os)
     mBuilder.finalize(os);
 }
 
+void ZEBinaryBuilder::getBinaryObject(std::unique_ptr<char[]>& buffer, size_t& size)
+{
+    if (!mZEInfoBuilder.empty())
+        mBuilder.addSectionZEInfo(mZEInfoBuilder.getZEInfoContainer());
+    size = (size_t)mBuilder.finalize([&buffer](uint64_t objSize) {
+        buffer.reset(new char[objSize]);
+        return buffer.get();
+    });
+}
+
 void ZEBinaryBuilder::getBinaryObject(Util::BinaryStream& outputStream)
 {
-    llvm::SmallVector<char, 64> buf;
-    llvm::raw_svector_ostream llvm_os(buf);
-    getBinaryObject(llvm_os);
-    outputStream.Write(buf.data(), buf.size());
+    std::unique_ptr<char[]> buf;
+    size_t size = 0;
+    getBinaryObject(buf, size);
+    outputStream.Write(buf.get(), size);
 }
 
 void ZEBinaryBuilder::printBinaryObject(const std::string& filename)
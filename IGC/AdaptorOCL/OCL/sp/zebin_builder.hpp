@@ -83,6 +83,10 @@ public:
     /// getBinaryObject - get the final ze object
     void getBinaryObject(llvm::raw_pwrite_stream& os);
 
+    /// getBinaryObject - write the final ze object straight into a newly
+    /// allocated buffer of exactly the object's size
+    void getBinaryObject(std::unique_ptr<char[]>& buffer, size_t& size);
+
     // getBinaryObject - write the final object into given Util::BinaryStream
     // Avoid using this function, which has extra buffer copy
     void getBinaryObject(Util::BinaryStream& outputStream);
@@ -432,8 +432,9 @@ public:
           }
 
           unsigned int numOperands = 0;
-          if (SPIRVDebug::OpCountMap.find(op) != SPIRVDebug::OpCountMap.end())
-              numOperands = SPIRVDebug::OpCountMap[op];
+          auto opCount = SPIRVDebug::OpCountMap.find(op);
+          if (opCount != SPIRVDebug::OpCountMap.end())
+              numOperands = opCount->second;
 
           if (numOperands > 0)
           {
@@ -287,7 +287,7 @@ namespace igc_spv {
             Reinterpret = 164
         };
 
-        static std::unordered_map<ExpressionOpCode, unsigned> OpCountMap{
+        static const std::unordered_map<ExpressionOpCode, unsigned> OpCountMap{
         { Deref,              1 },
         { Plus,               1 },
         { Minus,              1 },
@@ -778,7 +778,7 @@ namespace igc_spv {
                 enum {
                     OpCodeIdx = 0
                 };
-                static std::map<ExpressionOpCode, unsigned> OpCountMap{
+                static const std::map<ExpressionOpCode, unsigned> OpCountMap{
                     { Deref,      1 },
                     { Plus,       2 },
                     { Minus,      2 },
@@ -147,7 +147,7 @@ SPIRVInstruction::getOperandTypes() {
 
 bool
 isSpecConstantOpAllowedOp(Op OC) {
-  static SPIRVWord Table[] =
+  static const SPIRVWord Table[] =
   {
     OpSConvert,
     OpFConvert,
@@ -208,7 +208,7 @@ isSpecConstantOpAllowedOp(Op OC) {
     OpPtrAccessChain,
     OpInBoundsPtrAccessChain,
   };
-  static std::unordered_set<SPIRVWord>
+  static const std::unordered_set<SPIRVWord>
     Allow(std::begin(Table), std::end(Table));
   return (Allow.count(OC) > 0);
 }
@@ -0,0 +1,411 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "AdaptorOCL/TieredCompilation.hpp"
+
+#include "common/igc_regkeys.hpp"
+#include "Probe/Assertion.h"
+
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/xxhash.h"
+#include "common/LLVMWarningsPop.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace llvm;
+
+namespace TC
+{
+
+namespace
+{
+    // A tier-1 build with copies of everything its input arguments point to.
+    struct Job
+    {
+        uint64_t Key = 0;
+        TieredCompilation::TranslateFn Translate;
+        std::vector<char> Input;
+        std::string Options;
+        std::string InternalOptions;
+        std::vector<uint32_t> SpecConstantsIds;
+        std::vector<uint64_t> SpecConstantsValues;
+        STB_TranslateInputArgs InputArgs;
+    };
+
+    struct Result
+    {
+        TieredCompilation::Status Status = TieredCompilation::Status::Pending;
+        STB_TranslateOutputArgs OutputArgs;
+    };
+
+    // The background builds run on this thread.
+    thread_local bool IsWorkerThread = false;
+
+    void stopWorkerAtExit();
+
+    class Worker
+    {
+    public:
+        void enqueue(std::unique_ptr<Job> J, size_t MaxResults)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+                if (m_Stop)
+                    return;
+                // The same program is only built once until its output is taken.
+                if (m_Results.count(J->Key))
+                    return;
+                if (m_Results.size() >= MaxResults && !evictOldestDone())
+                    return;
+                m_Results.emplace(J->Key, Result());
+                m_Order.push_back(J->Key);
+                m_Queue.push_back(std::move(J));
+                if (!m_Thread.joinable())
+                {
+                    m_Thread = std::thread(&Worker::run, this);
+                    // Registered after the static objects the builds use
+                    // were constructed, so it runs before they are destroyed,
+                    // at exit and when the library is unloaded.
+                    std::atexit(stopWorkerAtExit);
+                }
+            }
+            m_Cond.notify_all();
+        }
+
+        void setReadyCallback(TieredCompilation::ReadyCallback Callback, void* UserData)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_Callback = Callback;
+            m_CallbackUserData = UserData;
+        }
+
+        TieredCompilation::Status query(uint64_t Key)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            auto It = m_Results.find(Key);
+            return It == m_Results.end() ? TieredCompilation::Status::Unknown : It->second.Status;
+        }
+
+        TieredCompilation::Status take(uint64_t Key, STB_TranslateOutputArgs& OutputArgs)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            auto It = m_Results.find(Key);
+            if (It == m_Results.end())
+                return TieredCompilation::Status::Unknown;
+            TieredCompilation::Status Status = It->second.Status;
+            if (Status != TieredCompilation::Status::Pending)
+            {
+                OutputArgs = It->second.OutputArgs;
+                m_Results.erase(It);
+                m_Order.erase(std::find(m_Order.begin(), m_Order.end(), Key));
+            }
+            return Status;
+        }
+
+        void waitForAll()
+        {
+            // The ready callback runs on the worker thread, which would wait
+            // for itself.
+            IGC_ASSERT_MESSAGE(!IsWorkerThread, "WaitForAll called from the tier-1 ready callback");
+            if (IsWorkerThread)
+                return;
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            m_Cond.wait(Lock, [this]() { return m_Stop || (m_Queue.empty() && !m_Busy); });
+        }
+
+        void beginTranslation()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            ++m_NumTranslations;
+        }
+
+        void endTranslation()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+                --m_NumTranslations;
+            }
+            m_Cond.notify_all();
+        }
+
+        // Queued builds are dropped and no other one starts. A build that
+        // is running can't be interrupted, it is waited for so that it
+        // doesn't use the library while its static objects are destroyed.
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+                m_Stop = true;
+                m_Queue.clear();
+            }
+            m_Cond.notify_all();
+            if (!m_Thread.joinable())
+                return;
+            // Exiting from the ready callback: the thread is the one exiting.
+            if (IsWorkerThread)
+                m_Thread.detach();
+            else
+                m_Thread.join();
+        }
+
+    private:
+        // Drops the oldest result that is not pending, false if there is
+        // none.
+        bool evictOldestDone()
+        {
+            for (auto It = m_Order.begin(); It != m_Order.end(); ++It)
+            {
+                auto R = m_Results.find(*It);
+                if (R->second.Status == TieredCompilation::Status::Pending)
+                    continue;
+                delete[] R->second.OutputArgs.pOutput;
+                delete[] R->second.OutputArgs.pErrorString;
+                delete[] R->second.OutputArgs.pDebugData;
+                m_Results.erase(R);
+                m_Order.erase(It);
+                return true;
+            }
+            return false;
+        }
+
+        void run()
+        {
+            IsWorkerThread = true;
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            while (true)
+            {
+                // Wait for the application to have no translation in flight.
+                m_Cond.wait(Lock, [this]() {
+                    return m_Stop || (!m_Queue.empty() && m_NumTranslations == 0);
+                });
+                if (m_Stop)
+                    return;
+
+                std::unique_ptr<Job> J = std::move(m_Queue.front());
+                m_Queue.pop_front();
+                m_Busy = true;
+                Lock.unlock();
+
+                STB_TranslateOutputArgs OutputArgs;
+                bool Success = false;
+                try
+                {
+                    Success = J->Translate(&J->InputArgs, &OutputArgs);
+                }
+                catch (...)
+                {
+                    Success = false;
+                }
+                TieredCompilation::Status Status =
+                    Success ? TieredCompilation::Status::Ready : TieredCompilation::Status::Failed;
+
+                Lock.lock();
+                auto It = m_Results.find(J->Key);
+                if (It != m_Results.end())
+                {
+                    It->second.Status = Status;
+                    It->second.OutputArgs = OutputArgs;
+                }
+                TieredCompilation::ReadyCallback Callback = m_Callback;
+                void* UserData = m_CallbackUserData;
+                // The build is done before the callback hears of it, for
+                // waiters not to depend on what the callback does.
+                m_Busy = false;
+                Lock.unlock();
+                m_Cond.notify_all();
+
+                if (Callback)
+                    Callback(J->Key, Status, UserData);
+
+                Lock.lock();
+            }
+        }
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Cond;
+        std::deque<std::unique_ptr<Job>> m_Queue;
+        std::unordered_map<uint64_t, Result> m_Results;
+        // Keys of m_Results, oldest first.
+        std::deque<uint64_t> m_Order;
+        TieredCompilation::ReadyCallback m_Callback = nullptr;
+        void* m_CallbackUserData = nullptr;
+        unsigned m_NumTranslations = 0;
+        std::thread m_Thread;
+        bool m_Busy = false;
+        bool m_Stop = false;
+    };
+
+    // The worker outlives the static objects of the library, for its thread
+    // to never see it destroyed; the thread is joined by stopWorkerAtExit.
+    Worker& getWorker()
+    {
+        static Worker* W = new Worker();
+        return *W;
+    }
+
+    void stopWorkerAtExit()
+    {
+        getWorker().stop();
+    }
+
+    // All the spellings of the option (-cl-intel-, -ze-opt-, ...) end the same.
+    bool isTieredOption(StringRef Option)
+    {
+        return Option.endswith("-tiered-compilation");
+    }
+} // namespace
+
+bool TieredCompilation::IsRequested(const STB_TranslateInputArgs& InputArgs, std::string& Tier1InternalOptions)
+{
+    if (InputArgs.pInternalOptions == nullptr)
+        return false;
+
+    bool Requested = false;
+    Tier1InternalOptions.clear();
+    SmallVector<StringRef, 16> Options;
+    StringRef(InputArgs.pInternalOptions).split(Options, ' ', -1, /*KeepEmpty=*/false);
+    for (StringRef Option : Options)
+    {
+        if (isTieredOption(Option))
+        {
+            Requested = true;
+            continue;
+        }
+        if (!Tier1InternalOptions.empty())
+            Tier1InternalOptions += ' ';
+        Tier1InternalOptions += Option.str();
+    }
+    return Requested;
+}
+
+bool TieredCompilation::IsSupported(const STB_TranslateInputArgs& InputArgs)
+{
+    if (InputArgs.GTPinInput || InputArgs.pTracingOptions ||
+        InputArgs.NumVISAAsmsToLink || InputArgs.NumDirectCallFunctions)
+        return false;
+
+    // Vector compiler builds ignore the tier-0 settings.
+    if (InputArgs.pOptions && (strstr(InputArgs.pOptions, "-vc-codegen") ||
+                               strstr(InputArgs.pOptions, "-cmc")))
+        return false;
+
+    return true;
+}
+
+bool TieredCompilation::Prepare(STB_TranslateInputArgs& InputArgs, STB_TranslateInputArgs& Tier1InputArgs,
+    std::string& Tier1InternalOptions)
+{
+    Tier1InputArgs = InputArgs;
+    if (!IsRequested(InputArgs, Tier1InternalOptions))
+        return false;
+
+    Tier1InputArgs.pInternalOptions = Tier1InternalOptions.c_str();
+    Tier1InputArgs.InternalOptionsSize = Tier1InternalOptions.size();
+    if (!IsSupported(InputArgs))
+    {
+        InputArgs = Tier1InputArgs;
+        return false;
+    }
+    return true;
+}
+
+uint64_t TieredCompilation::GetKey(const STB_TranslateInputArgs& InputArgs)
+{
+    auto bytesHash = [](const void* Data, size_t Size) {
+        return Data ? xxHash64(ArrayRef<uint8_t>(static_cast<const uint8_t*>(Data), Size)) : 0;
+    };
+    hash_code Key = hash_combine(
+        bytesHash(InputArgs.pInput, InputArgs.InputSize),
+        bytesHash(InputArgs.pOptions, InputArgs.OptionsSize),
+        bytesHash(InputArgs.pInternalOptions, InputArgs.InternalOptionsSize),
+        bytesHash(InputArgs.pSpecConstantsIds, InputArgs.SpecConstantsSize * sizeof(uint32_t)),
+        bytesHash(InputArgs.pSpecConstantsValues, InputArgs.SpecConstantsSize * sizeof(uint64_t)));
+    return static_cast<uint64_t>(static_cast<size_t>(Key));
+}
+
+void TieredCompilation::Enqueue(uint64_t Key, const STB_TranslateInputArgs& Tier1InputArgs, TranslateFn Translate)
+{
+    auto J = std::make_unique<Job>();
+    J->Key = Key;
+    J->Translate = std::move(Translate);
+    if (Tier1InputArgs.pInput)
+        J->Input.assign(Tier1InputArgs.pInput, Tier1InputArgs.pInput + Tier1InputArgs.InputSize);
+    if (Tier1InputArgs.pOptions)
+        J->Options.assign(Tier1InputArgs.pOptions, Tier1InputArgs.OptionsSize);
+    if (Tier1InputArgs.pInternalOptions)
+        J->InternalOptions.assign(Tier1InputArgs.pInternalOptions, Tier1InputArgs.InternalOptionsSize);
+    if (Tier1InputArgs.SpecConstantsSize)
+    {
+        J->SpecConstantsIds.assign(Tier1InputArgs.pSpecConstantsIds,
+            Tier1InputArgs.pSpecConstantsIds + Tier1InputArgs.SpecConstantsSize);
+        J->SpecConstantsValues.assign(Tier1InputArgs.pSpecConstantsValues,
+            Tier1InputArgs.pSpecConstantsValues + Tier1InputArgs.SpecConstantsSize);
+    }
+
+    STB_TranslateInputArgs& Args = J->InputArgs;
+    Args.pInput = J->Input.data();
+    Args.InputSize = Tier1InputArgs.InputSize;
+    Args.pOptions = Tier1InputArgs.pOptions ? J->Options.c_str() : nullptr;
+    Args.OptionsSize = Tier1InputArgs.OptionsSize;
+    Args.pInternalOptions = Tier1InputArgs.pInternalOptions ? J->InternalOptions.c_str() : nullptr;
+    Args.InternalOptionsSize = Tier1InputArgs.InternalOptionsSize;
+    Args.CompileTimeStatisticsEnable = Tier1InputArgs.CompileTimeStatisticsEnable;
+    Args.pSpecConstantsIds = J->SpecConstantsIds.data();
+    Args.pSpecConstantsValues = J->SpecConstantsValues.data();
+    Args.SpecConstantsSize = Tier1InputArgs.SpecConstantsSize;
+
+    getWorker().enqueue(std::move(J), IGC_GET_FLAG_VALUE(TieredCompilationMaxResults));
+}
+
+void TieredCompilation::SetReadyCallback(ReadyCallback Callback, void* UserData)
+{
+    getWorker().setReadyCallback(Callback, UserData);
+}
+
+TieredCompilation::Status TieredCompilation::Query(uint64_t Key)
+{
+    return getWorker().query(Key);
+}
+
+TieredCompilation::Status TieredCompilation::Take(uint64_t Key, STB_TranslateOutputArgs& OutputArgs)
+{
+    return getWorker().take(Key, OutputArgs);
+}
+
+void TieredCompilation::WaitForAll()
+{
+    getWorker().waitForAll();
+}
+
+TieredCompilation::TranslationScope::TranslationScope()
+    : m_Counted(!IsWorkerThread)
+{
+    if (m_Counted)
+        getWorker().beginTranslation();
+}
+
+TieredCompilation::TranslationScope::~TranslationScope()
+{
+    if (m_Counted)
+        getWorker().endTranslation();
+}
+
+} // namespace TC
@@ -0,0 +1,110 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "AdaptorOCL/TranslationBlock.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace TC
+{
+    /// Tiered builds of OpenCL programs.
+    ///
+    /// A translation with the tiered-compilation internal option
+    /// (-cl-intel-tiered-compilation, -ze-opt-tiered-compilation) returns a
+    /// tier-0 binary compiled for compile time only: reduced optimization
+    /// pipeline, a single SIMD width and linear scan register allocation.
+    /// The same program is queued for a regular, fully optimized build on a
+    /// background thread, whose output the caller picks up with Take() once
+    /// it is ready, either by polling Query() or from the ready callback.
+    /// The driver reaches this through IgcOclTranslationCtx version 4.
+    ///
+    /// A background build only starts while no other translation is in
+    /// progress, so it doesn't compete with the builds an application is
+    /// waiting for; translations that come in while it runs don't wait for
+    /// it. At most TieredCompilationMaxResults builds are kept, pending or
+    /// not taken yet, the oldest finished ones are dropped first.
+    ///
+    /// At exit or unload, queued builds are dropped and the one that is
+    /// running, if any, is waited for.
+    class TieredCompilation
+    {
+    public:
+        enum class Status
+        {
+            Unknown,    // not a tiered build, or already taken
+            Pending,
+            Ready,
+            Failed,
+        };
+
+        /// Called on the background thread once the tier-1 build of Key is
+        /// done, with Ready or Failed. It must not call WaitForAll().
+        typedef void (*ReadyCallback)(uint64_t Key, Status Result, void* UserData);
+
+        typedef std::function<bool(const STB_TranslateInputArgs*, STB_TranslateOutputArgs*)> TranslateFn;
+
+        /// Returns true if InputArgs asks for a tiered build, with the
+        /// internal options of the tier-1 build (the tiered option removed)
+        /// in Tier1InternalOptions.
+        static bool IsRequested(const STB_TranslateInputArgs& InputArgs, std::string& Tier1InternalOptions);
+
+        /// Translations with inputs the background build can't reproduce
+        /// (instrumentation, vISA to link) or that don't go through the
+        /// scalar backend are built once, with the tier-1 options.
+        static bool IsSupported(const STB_TranslateInputArgs& InputArgs);
+
+        /// Returns true if InputArgs is the tier-0 build of a tiered
+        /// translation, with the arguments of its tier-1 build, which point
+        /// to Tier1InternalOptions, in Tier1InputArgs. An unsupported tiered
+        /// translation has the tiered option removed from InputArgs.
+        static bool Prepare(STB_TranslateInputArgs& InputArgs, STB_TranslateInputArgs& Tier1InputArgs,
+            std::string& Tier1InternalOptions);
+
+        /// Identifies the tier-1 build of a translation, from the same input
+        /// arguments that were given to Translate().
+        static uint64_t GetKey(const STB_TranslateInputArgs& InputArgs);
+
+        /// Queues the tier-1 build. Everything Tier1InputArgs points to is
+        /// copied. Nothing is queued if TieredCompilationMaxResults builds
+        /// are already pending.
+        static void Enqueue(uint64_t Key, const STB_TranslateInputArgs& Tier1InputArgs, TranslateFn Translate);
+
+        static void SetReadyCallback(ReadyCallback Callback, void* UserData);
+
+        static Status Query(uint64_t Key);
+
+        /// Moves the tier-1 output of Key, or its error message if it failed,
+        /// into OutputArgs. The buffers are released with FreeAllocations()
+        /// like those of Translate(). Nothing is moved while the build is
+        /// pending.
+        static Status Take(uint64_t Key, STB_TranslateOutputArgs& OutputArgs);
+
+        /// Blocks until all the queued builds are done. Not to be called
+        /// from the ready callback.
+        static void WaitForAll();
+
+        /// Held by every translation requested by the application, for the
+        /// background builds to start only once they are done.
+        class TranslationScope
+        {
+        public:
+            TranslationScope();
+            ~TranslationScope();
+
+            TranslationScope(const TranslationScope&) = delete;
+            TranslationScope& operator=(const TranslationScope&) = delete;
+
+        private:
+            bool m_Counted;
+        };
+    };
+} // namespace TC
@@ -27,6 +27,8 @@ SPDX-License-Identifier: MIT
 #include "AdaptorOCL/OCL/TB/igc_tb.h"
 
 #include "AdaptorOCL/UnifyIROCL.hpp"
+#include "AdaptorOCL/CompilationCache.hpp"
+#include "AdaptorOCL/TieredCompilation.hpp"
 #include "AdaptorOCL/DriverInfoOCL.hpp"
 
 #include "Compiler/CISACodeGen/OpenCLKernelCodeGen.hpp"
@@ -36,6 +38,7 @@ SPDX-License-Identifier: MIT
 #include "common/igc_regkeys.hpp"
 #include "common/secure_mem.h"
 #include "common/shaderOverride.hpp"
+#include "common/TraceEvents.hpp"
 #include "common/ModuleSplitter.h"
 #include "common/IGCSPIRVParser.h"
 
@@ -67,6 +70,7 @@ SPDX-License-Identifier: MIT
 
 #include "common/LLVMWarningsPush.hpp"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Transforms/Utils/Cloning.h"
 #include "common/LLVMWarningsPop.hpp"
 
 #include <sstream>
@@ -242,6 +246,10 @@ bool CIGCTranslationBlock::Translate(
 {
     LoadRegistryKeys();
 
+    // Background tier-1 builds start once the translations of the
+    // application are done.
+    TieredCompilation::TranslationScope TranslationScope;
+
     // Create a copy of input arguments that can be modified
     STB_TranslateInputArgs InputArgsCopy = *pInputArgs;
 
@@ -283,7 +291,29 @@ bool CIGCTranslationBlock::Translate(
             (m_DataFormatInput == TB_DATA_FORMAT_SPIR_V) ||
             (m_DataFormatInput == TB_DATA_FORMAT_LLVM_BINARY))
         {
-            return TC::TranslateBuild(&InputArgsCopy, pOutputArgs, m_DataFormatInput, IGCPlatform, m_ProfilingTimerResolution);
+            // A tiered build returns the tier-0 binary and queues the tier-1
+            // build, which is a regular translation of the same program
+            // without the tiered option.
+            std::string Tier1InternalOptions;
+            STB_TranslateInputArgs Tier1InputArgs;
+            bool Tiered = TieredCompilation::Prepare(InputArgsCopy, Tier1InputArgs, Tier1InternalOptions);
+
+            // Tier-0 binaries are not cached, the next build of the program
+            // should get the tier-1 one.
+            bool success = Tiered
+                ? TC::TranslateBuild(&InputArgsCopy, pOutputArgs, m_DataFormatInput, IGCPlatform, m_ProfilingTimerResolution)
+                : CompilationCache::TranslateBuild(&InputArgsCopy, pOutputArgs, m_DataFormatInput, m_DataFormatOutput,
+                    IGCPlatform, m_ProfilingTimerResolution);
+            if (success && Tiered)
+            {
+                std::shared_ptr<CIGCTranslationBlock> Tier1Block(new CIGCTranslationBlock(*this),
+                    [](CIGCTranslationBlock* pBlock) { CIGCTranslationBlock::Delete(pBlock); });
+                TieredCompilation::Enqueue(TieredCompilation::GetKey(*pInputArgs), Tier1InputArgs,
+                    [Tier1Block](const STB_TranslateInputArgs* pArgs, STB_TranslateOutputArgs* pOutArgs) {
+                        return Tier1Block->Translate(pArgs, pOutArgs);
+                    });
+            }
+            return success;
         }
         else
         {
@@ -1028,6 +1058,84 @@ void RebuildGlobalAnnotations(IGC::OpenCLProgramContext& oclContext, Module* pKe
     GV->setSection("llvm.metadata");
 }
 
+static bool CanRetryFromUnifiedModule(const IGC::OpenCLProgramContext& oclContext)
+{
+    if (IGC_IS_FLAG_DISABLED(RetryFromUnifiedModule) ||
+        oclContext.m_retryManager.IsLastTry())
+    {
+        return false;
+    }
+    // The symbol table kernel is created during unification for the kernels
+    // that are compiled, it cannot be reused for a subset of them.
+    for (auto& F : *oclContext.getModule())
+    {
+        if (IGC::isIntelSymbolTableVoidProgram(&F))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Module right after unification, along with the flags of the context that
+// unification sets (ProcessFuncAttributes, BuiltinImport) and that the call
+// model of the code generation depends on.
+struct UnifiedModule
+{
+    std::unique_ptr<llvm::Module> module;
+    bool enableSubroutine = false;
+    bool enableFunctionPointer = false;
+    bool hasStackCalls = false;
+    bool enableSimdVariantCompilation = false;
+};
+
+static std::unique_ptr<UnifiedModule> SaveUnifiedModule(IGC::OpenCLProgramContext& oclContext)
+{
+    COMPILER_TIME_START(&oclContext, TIME_OCL_SaveUnifiedModule);
+    // Make the metadata part of the module so that it is cloned along with it
+    oclContext.getMetaDataUtils()->save(*oclContext.getLLVMContext());
+    IGC::serialize(*oclContext.getModuleMetaData(), oclContext.getModule());
+    auto unifiedModule = std::make_unique<UnifiedModule>();
+    unifiedModule->module = llvm::CloneModule(*oclContext.getModule());
+    unifiedModule->enableSubroutine = oclContext.m_enableSubroutine;
+    unifiedModule->enableFunctionPointer = oclContext.m_enableFunctionPointer;
+    unifiedModule->hasStackCalls = oclContext.m_hasStackCalls;
+    unifiedModule->enableSimdVariantCompilation = oclContext.m_enableSimdVariantCompilation;
+    COMPILER_TIME_END(&oclContext, TIME_OCL_SaveUnifiedModule);
+    return unifiedModule;
+}
+
+// Replace the module of the context with a copy of the unified module that
+// only keeps the kernels that need to be recompiled. Unification is skipped
+// on the retry, so the flags it set are restored as they were after it.
+static void RestoreUnifiedModuleForRetry(IGC::OpenCLProgramContext& oclContext, const UnifiedModule& unifiedModule)
+{
+    llvm::Module* pKernelModule = llvm::CloneModule(*unifiedModule.module).release();
+    oclContext.deleteModule();
+    oclContext.m_enableSubroutine = unifiedModule.enableSubroutine;
+    oclContext.m_enableFunctionPointer = unifiedModule.enableFunctionPointer;
+    oclContext.m_hasStackCalls = unifiedModule.hasStackCalls;
+    oclContext.m_enableSimdVariantCompilation = unifiedModule.enableSimdVariantCompilation;
+    oclContext.setModule(pKernelModule);
+    deserialize(*oclContext.getModuleMetaData(), pKernelModule);
+
+    RebuildGlobalAnnotations(oclContext, pKernelModule);
+
+    for (auto it = pKernelModule->begin(), ie = pKernelModule->end(); it != ie;)
+    {
+        Function* pFunc = &*(it++);
+        // Only retry compilation on kernels that need it
+        if (pFunc->getCallingConv() == llvm::CallingConv::SPIR_KERNEL &&
+            pFunc->use_empty() &&
+            oclContext.m_retryManager.kernelSet.find(pFunc->getName().str()) == oclContext.m_retryManager.kernelSet.end())
+        {
+            IGCMetaDataHelper::removeFunction(*oclContext.getMetaDataUtils(), *oclContext.getModuleMetaData(), pFunc);
+            pFunc->eraseFromParent();
+        }
+    }
+    oclContext.getMetaDataUtils()->save(*oclContext.getLLVMContext());
+}
+
 #if defined(IGC_SPIRV_ENABLED)
 bool ReadSpecConstantsFromSPIRV(
     std::istream& IS,
@@ -1277,6 +1385,7 @@ bool TranslateBuildSPMD(
 #pragma GCC diagnostic pop
 #endif // __GNUC__
 
+    TraceEvents::attachVISATimers();
     COMPILER_TIME_START(&oclContext, TIME_TOTAL);
     oclContext.m_ProfilingTimerResolution = profilingTimerResolution;
 
@@ -1316,7 +1425,15 @@ bool TranslateBuildSPMD(
                          IGC_IS_FLAG_ENABLED(CompileOneAtTime);
     // set retry manager
     bool retry = false;
-    oclContext.m_retryManager.Enable(ShaderType::OPENCL_SHADER);
+    // A tier-0 binary is not worth a second compile.
+    if (!oclContext.m_InternalOptions.TieredCompilation)
+    {
+        oclContext.m_retryManager.Enable(ShaderType::OPENCL_SHADER);
+    }
+    // Module right after unification, a retry restarts from it instead of
+    // parsing and unifying the input again.
+    std::unique_ptr<UnifiedModule> unifiedModule;
+    bool resumeFromUnifiedModule = false;
     do
     {
         llvm::TinyPtrVector<const llvm::Function*> kernelFunctions;
@@ -1356,6 +1473,7 @@ bool TranslateBuildSPMD(
             std::unique_ptr<llvm::Module> BuiltinSizeModule = nullptr;
             std::unique_ptr<llvm::MemoryBuffer> pGenericBuffer = nullptr;
             std::unique_ptr<llvm::MemoryBuffer> pSizeTBuffer = nullptr;
+            if (!resumeFromUnifiedModule)
             {
                 // IGC has two BIF Modules:
                 //            1. kernel Module (pKernelModule)
@@ -1450,26 +1568,34 @@ bool TranslateBuildSPMD(
 
             try
             {
-                if (llvm::StringRef(oclContext.getModule()->getTargetTriple()).startswith("spir"))
-                {
-                    IGC::UnifyIRSPIR(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
-                }
-                else // not SPIR
+                if (!resumeFromUnifiedModule)
                 {
-                    IGC::UnifyIROCL(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
-                }
+                    if (llvm::StringRef(oclContext.getModule()->getTargetTriple()).startswith("spir"))
+                    {
+                        IGC::UnifyIRSPIR(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
+                    }
+                    else // not SPIR
+                    {
+                        IGC::UnifyIROCL(&oclContext, std::move(BuiltinGenericModule), std::move(BuiltinSizeModule));
+                    }
 
-                if (oclContext.HasError())
-                {
-                    if (oclContext.HasWarning())
+                    if (oclContext.HasError())
                     {
-                        SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
+                        if (oclContext.HasWarning())
+                        {
+                            SetOutputMessage(oclContext.GetErrorAndWarning(), *pOutputArgs);
+                        }
+                        else
+                        {
+                            SetOutputMessage(oclContext.GetError(), *pOutputArgs);
+                        }
+                        return false;
                     }
-                    else
+
+                    if (!doSplitModule && CanRetryFromUnifiedModule(oclContext))
                     {
-                        SetOutputMessage(oclContext.GetError(), *pOutputArgs);
+                        unifiedModule = SaveUnifiedModule(oclContext);
                     }
-                    return false;
                 }
 
                 // Compiler Options information available after unification.
@@ -1479,6 +1605,11 @@ bool TranslateBuildSPMD(
                     oclContext.m_floatDenormMode16 = FLOAT_DENORM_FLUSH_TO_ZERO;
                     oclContext.m_floatDenormMode32 = FLOAT_DENORM_FLUSH_TO_ZERO;
                 }
+                if (oclContext.m_InternalOptions.TieredCompilation)
+                {
+                    // Tier-0 of a tiered build, see TieredCompilation.hpp.
+                    modMD->compOpt.FastCompilation = true;
+                }
                 if (IGC_GET_FLAG_VALUE(ForceFastestSIMD))
                 {
                     oclContext.m_retryManager.AdvanceState();
@@ -1512,7 +1643,15 @@ bool TranslateBuildSPMD(
             retry = (!oclContext.m_retryManager.kernelSet.empty() &&
                      oclContext.m_retryManager.AdvanceState());
 
-            if (retry)
+            if (retry && unifiedModule)
+            {
+                oclContext.clearBeforeRetry();
+                RestoreUnifiedModuleForRetry(oclContext, *unifiedModule);
+                // The module pKernelModule pointed to was deleted by the restore.
+                pKernelModule = oclContext.getModule();
+                resumeFromUnifiedModule = true;
+            }
+            else if (retry)
             {
                 splitter.retry();
                 kernelFunctions.clear();
@@ -1591,8 +1730,6 @@ bool TranslateBuildSPMD(
     else
     {
         // ze binary foramt
-        llvm::SmallVector<char, 64> buf;
-        llvm::raw_svector_ostream llvm_os(buf);
         const bool excludeIRFromZEBinary = IGC_IS_FLAG_ENABLED(ExcludeIRFromZEBinary) || oclContext.getModuleMetaData()->compOpt.ExcludeIRFromZEBinary;
         const char* spv_data = nullptr;
         uint32_t spv_size = 0;
@@ -1606,13 +1743,11 @@ bool TranslateBuildSPMD(
         size_t metricDataSize = oclContext.metrics.getMetricDataSize();
         auto metricData = reinterpret_cast<const char*>(oclContext.metrics.getMetricData());
 
-        oclContext.m_programOutput.GetZEBinary(llvm_os, pointerSizeInBytes,
+        // the binary is written straight into the output buffer
+        std::unique_ptr<char[]> zeBinary;
+        oclContext.m_programOutput.GetZEBinary(zeBinary, binarySize, pointerSizeInBytes,
             spv_data, spv_size, metricData, metricDataSize, pInputArgs->pOptions, pInputArgs->OptionsSize);
-
-        // FIXME: try to avoid memory copy here
-        binarySize = buf.size();
-        binaryOutput = new char[binarySize];
-        memcpy_s(binaryOutput, binarySize, buf.data(), buf.size());
+        binaryOutput = zeBinary.release();
     }
 
     if (IGC_IS_FLAG_ENABLED(ShaderDumpEnable))
@@ -1672,7 +1807,7 @@ bool TranslateBuildVC(
 }
 #endif // defined(IGC_VC_ENABLED)
 
-bool TranslateBuild(
+static bool TranslateBuildImpl(
     const STB_TranslateInputArgs* pInputArgs,
     STB_TranslateOutputArgs* pOutputArgs,
     TB_DATA_FORMAT inputDataFormatTemp,
@@ -1744,6 +1879,26 @@ bool TranslateBuild(
     return ret;
 }
 
+bool TranslateBuild(
+    const STB_TranslateInputArgs* pInputArgs,
+    STB_TranslateOutputArgs* pOutputArgs,
+    TB_DATA_FORMAT inputDataFormatTemp,
+    const IGC::CPlatform& IGCPlatform,
+    float profilingTimerResolution)
+{
+    // Every translation sets flags on its own copy of the regkeys, so that
+    // they neither leak into the next one nor race with the translations
+    // running on other threads. Only the keys that are set are copied.
+    RegKeysSnapshot RegKeys;
+
+    bool success = TranslateBuildImpl(pInputArgs, pOutputArgs, inputDataFormatTemp,
+        IGCPlatform, profilingTimerResolution);
+    // Done here rather than at the end of TranslateBuildSPMD so that failed
+    // translations are written to the trace too.
+    TraceEvents::flush();
+    return success;
+}
+
 bool CIGCTranslationBlock::FreeAllocations(STB_TranslateOutputArgs* pOutputArgs)
 {
     IGC_ASSERT(pOutputArgs);
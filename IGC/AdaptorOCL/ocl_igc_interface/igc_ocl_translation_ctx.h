@@ -110,6 +110,47 @@ protected:
                                                   void *gtPinInput);
 };
 
+namespace TieredBuildStatus {
+using TieredBuildStatus_t = uint32_t;
+constexpr TieredBuildStatus_t unknown = 0; // not a tiered build, or already taken
+constexpr TieredBuildStatus_t pending = 1;
+constexpr TieredBuildStatus_t ready = 2;
+constexpr TieredBuildStatus_t failed = 3;
+}
+
+// Tiered builds : a Translate() with -ze-opt-tiered-compilation (or
+// -cl-intel-tiered-compilation) in the internal options returns a binary
+// built for compile time only, and queues a regular build of the same program
+// in the background. Its output is identified by GetTier1Key() called with the
+// buffers given to Translate().
+CIF_DEFINE_INTERFACE_VER_WITH_COMPATIBILITY(IgcOclTranslationCtx, 4, 3) {
+  using IgcOclTranslationCtx<3>::TranslateImpl;
+  using IgcOclTranslationCtx<3>::Translate;
+
+  CIF_INHERIT_CONSTRUCTOR();
+
+  virtual uint64_t GetTier1Key(CIF::Builtins::BufferSimple *src,
+                               CIF::Builtins::BufferSimple *specConstantsIds,
+                               CIF::Builtins::BufferSimple *specConstantsValues,
+                               CIF::Builtins::BufferSimple *options,
+                               CIF::Builtins::BufferSimple *internalOptions);
+
+  virtual TieredBuildStatus::TieredBuildStatus_t QueryTier1(uint64_t key);
+
+  // Returns nullptr while the build is pending, or if there is none for key.
+  template <typename OclTranslationOutputInterface = OclTranslationOutputTagOCL>
+  CIF::RAII::UPtr_t<OclTranslationOutputInterface> TakeTier1(uint64_t key) {
+      auto p = TakeTier1Impl(OclTranslationOutputInterface::GetVersion(), key);
+      return CIF::RAII::Pack<OclTranslationOutputInterface>(p);
+  }
+
+  // Blocks until all the queued tier-1 builds are done.
+  virtual void WaitForTier1Builds();
+
+protected:
+  virtual OclTranslationOutputBase *TakeTier1Impl(CIF::Version_t outVersion, uint64_t key);
+};
+
 CIF_GENERATE_VERSIONS_LIST_AND_DECLARE_INTERFACE_DEPENDENCIES(IgcOclTranslationCtx, IGC::OclTranslationOutput, CIF::Builtins::Buffer);
 CIF_MARK_LATEST_VERSION(IgcOclTranslationCtxLatest, IgcOclTranslationCtx);
 using IgcOclTranslationCtxTagOCL = IgcOclTranslationCtxLatest; // Note : can tag with different version for
@@ -66,6 +66,29 @@ OclTranslationOutputBase *CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 3)::Tran
     return res;
 }
 
+uint64_t CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 4)::GetTier1Key(
+                            CIF::Builtins::BufferSimple *src,
+                            CIF::Builtins::BufferSimple *specConstantsIds,
+                            CIF::Builtins::BufferSimple *specConstantsValues,
+                            CIF::Builtins::BufferSimple *options,
+                            CIF::Builtins::BufferSimple *internalOptions) {
+    return CIF_GET_PIMPL()->GetTier1Key(src, specConstantsIds, specConstantsValues, options, internalOptions);
+}
+
+TieredBuildStatus::TieredBuildStatus_t CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 4)::QueryTier1(uint64_t key) {
+    return CIF_GET_PIMPL()->QueryTier1(key);
+}
+
+OclTranslationOutputBase *CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 4)::TakeTier1Impl(
+                                                 CIF::Version_t outVersion,
+                                                 uint64_t key) {
+    return CIF_GET_PIMPL()->TakeTier1(outVersion, key);
+}
+
+void CIF_GET_INTERFACE_CLASS(IgcOclTranslationCtx, 4)::WaitForTier1Builds() {
+    CIF_GET_PIMPL()->WaitForTier1Builds();
+}
+
 }
 
 #include "cif/macros/disable.h"
@@ -27,6 +27,8 @@ SPDX-License-Identifier: MIT
 #include <spirv-tools/libspirv.h>
 
 #include "Compiler/CISACodeGen/OpenCLKernelCodeGen.hpp"
+#include "AdaptorOCL/CompilationCache.hpp"
+#include "AdaptorOCL/TieredCompilation.hpp"
 
 namespace TC{
 
@@ -225,6 +227,10 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
             return outputInterface.release();
         }
 
+        // Background tier-1 builds start once the translations of the
+        // application are done.
+        TC::TieredCompilation::TranslationScope translationScope;
+
         TC::STB_TranslateInputArgs inputArgs;
         if(src != nullptr){
             if (gtPinInput)
@@ -258,6 +264,9 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
         }
         inputArgs.GTPinInput = gtPinInput;
 
+        // Identifies the tier-1 build by the buffers of the driver, see GetTier1Key().
+        uint64_t tier1Key = TC::TieredCompilation::GetKey(inputArgs);
+
         CIF::Sanity::NotNullOrAbort(this->globalState.GetPlatformImpl());
         auto platform = this->globalState.GetPlatformImpl()->p;
 
@@ -323,6 +332,13 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
             inputArgs.InternalOptionsSize = combinedInternalOptions.size();
         }
 
+        // A tiered build returns the tier-0 binary and queues the tier-1
+        // build, which is a regular translation of the same program without
+        // the tiered option.
+        std::string tier1InternalOptions;
+        TC::STB_TranslateInputArgs tier1InputArgs;
+        bool tiered = TC::TieredCompilation::Prepare(inputArgs, tier1InputArgs, tier1InternalOptions);
+
         bool success = false;
         try
         {
@@ -349,12 +365,38 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
                     (this->inType == CodeType::llvmBc))
                 {
                     TC::TB_DATA_FORMAT inFormatLegacy = toLegacyFormat(this->inType);
-                    success = TC::TranslateBuild(
-                        &inputArgs,
-                        &output,
-                        inFormatLegacy,
-                        igcPlatform,
-                        this->globalState.MiscOptions.ProfilingTimerResolution);
+                    TC::TB_DATA_FORMAT outFormatLegacy = toLegacyFormat(this->outType);
+                    float profilingTimerResolution = this->globalState.MiscOptions.ProfilingTimerResolution;
+                    // Tier-0 binaries are not cached, the next build of the
+                    // program should get the tier-1 one.
+                    if (tiered)
+                    {
+                        success = TC::TranslateBuild(
+                            &inputArgs,
+                            &output,
+                            inFormatLegacy,
+                            igcPlatform,
+                            profilingTimerResolution);
+                    }
+                    else
+                    {
+                        success = TC::CompilationCache::TranslateBuild(
+                            &inputArgs,
+                            &output,
+                            inFormatLegacy,
+                            outFormatLegacy,
+                            igcPlatform,
+                            profilingTimerResolution);
+                    }
+                    if (success && tiered)
+                    {
+                        TC::TieredCompilation::Enqueue(tier1Key, tier1InputArgs,
+                            [inFormatLegacy, outFormatLegacy, igcPlatform, profilingTimerResolution](
+                                const TC::STB_TranslateInputArgs* pArgs, TC::STB_TranslateOutputArgs* pOutArgs) {
+                                return TC::CompilationCache::TranslateBuild(pArgs, pOutArgs, inFormatLegacy,
+                                    outFormatLegacy, igcPlatform, profilingTimerResolution);
+                            });
+                    }
                 }
                 else
                 {
@@ -382,26 +424,72 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
             }
         }
 
-        auto outputData = std::unique_ptr<char[]>(output.pOutput);
-        auto errorString = std::unique_ptr<char[]>(output.pErrorString);
-        auto debugData = std::unique_ptr<char[]>(output.pDebugData);
+        if(MoveToOutput(success, output, *outputInterface->GetImpl()) == false){
+            return nullptr; // OOM
+        }
 
-        bool dataCopiedSuccessfuly = true;
-        if(success){
-            dataCopiedSuccessfuly &= outputInterface->GetImpl()->AddWarning(output.pErrorString, output.ErrorStringSize);
-            dataCopiedSuccessfuly &= outputInterface->GetImpl()->CloneDebugData(output.pDebugData, output.DebugDataSize);
-            dataCopiedSuccessfuly &= outputInterface->GetImpl()->SetSuccessfulAndCloneOutput(output.pOutput, output.OutputSize);
-        }else{
-            dataCopiedSuccessfuly &= outputInterface->GetImpl()->SetError(TranslationErrorType::FailedCompilation, output.pErrorString);
+        return outputInterface.release();
+    }
+
+    uint64_t GetTier1Key(CIF::Builtins::BufferSimple *src,
+                         CIF::Builtins::BufferSimple *specConstantsIds,
+                         CIF::Builtins::BufferSimple *specConstantsValues,
+                         CIF::Builtins::BufferSimple *options,
+                         CIF::Builtins::BufferSimple *internalOptions) const
+    {
+        // The same arguments as the ones Translate() gets the key from.
+        TC::STB_TranslateInputArgs inputArgs;
+        if(src != nullptr){
+            inputArgs.pInput = src->GetMemoryWriteable<char>();
+            inputArgs.InputSize = static_cast<uint32_t>(src->GetSizeRaw());
+        }
+        if(options != nullptr){
+            inputArgs.pOptions = options->GetMemory<char>();
+            inputArgs.OptionsSize = static_cast<uint32_t>(options->GetSizeRaw());
+        }
+        if(internalOptions != nullptr){
+            inputArgs.pInternalOptions = internalOptions->GetMemory<char>();
+            inputArgs.InternalOptionsSize = static_cast<uint32_t>(internalOptions->GetSizeRaw());
+        }
+        if(specConstantsIds != nullptr && specConstantsValues != nullptr){
+            inputArgs.pSpecConstantsIds = specConstantsIds->GetMemory<uint32_t>();
+            inputArgs.SpecConstantsSize = static_cast<uint32_t>(specConstantsIds->GetSizeRaw() / sizeof(uint32_t));
+            inputArgs.pSpecConstantsValues = specConstantsValues->GetMemory<uint64_t>();
         }
+        return TC::TieredCompilation::GetKey(inputArgs);
+    }
 
-        if(dataCopiedSuccessfuly == false){
+    TieredBuildStatus::TieredBuildStatus_t QueryTier1(uint64_t key) const
+    {
+        return toTieredBuildStatus(TC::TieredCompilation::Query(key));
+    }
+
+    OclTranslationOutputBase *TakeTier1(CIF::Version_t outVersion, uint64_t key) const
+    {
+        auto outputInterface = CIF::RAII::UPtr(CIF::InterfaceCreator<OclTranslationOutput>::CreateInterfaceVer(outVersion, this->outType));
+        if(outputInterface == nullptr){
+            return nullptr; // OOM
+        }
+
+        TC::STB_TranslateOutputArgs output;
+        CIF::SafeZeroOut(output);
+        TC::TieredCompilation::Status status = TC::TieredCompilation::Take(key, output);
+        if((status != TC::TieredCompilation::Status::Ready) && (status != TC::TieredCompilation::Status::Failed)){
+            return nullptr;
+        }
+
+        if(MoveToOutput(status == TC::TieredCompilation::Status::Ready, output, *outputInterface->GetImpl()) == false){
             return nullptr; // OOM
         }
 
         return outputInterface.release();
     }
 
+    void WaitForTier1Builds() const
+    {
+        TC::TieredCompilation::WaitForAll();
+    }
+
     OclTranslationOutputBase* GetErrorOutput(CIF::Version_t outVersion, unsigned int code) const
     {
         auto outputInterface = CIF::RAII::UPtr(CIF::InterfaceCreator<OclTranslationOutput>::CreateInterfaceVer(outVersion, this->outType));
@@ -435,6 +523,36 @@ CIF_DECLARE_INTERFACE_PIMPL(IgcOclTranslationCtx) : CIF::PimplBase
     }
 
 protected:
+    // Copies the buffers of output into outputImpl and releases them,
+    // returns false on OOM.
+    static bool MoveToOutput(bool success, TC::STB_TranslateOutputArgs& output, CIF_PIMPL(OclTranslationOutput)& outputImpl)
+    {
+        auto outputData = std::unique_ptr<char[]>(output.pOutput);
+        auto errorString = std::unique_ptr<char[]>(output.pErrorString);
+        auto debugData = std::unique_ptr<char[]>(output.pDebugData);
+
+        bool dataCopiedSuccessfuly = true;
+        if(success){
+            dataCopiedSuccessfuly &= outputImpl.AddWarning(output.pErrorString, output.ErrorStringSize);
+            dataCopiedSuccessfuly &= outputImpl.CloneDebugData(output.pDebugData, output.DebugDataSize);
+            dataCopiedSuccessfuly &= outputImpl.SetSuccessfulAndCloneOutput(output.pOutput, output.OutputSize);
+        }else{
+            dataCopiedSuccessfuly &= outputImpl.SetError(TranslationErrorType::FailedCompilation, output.pErrorString);
+        }
+        return dataCopiedSuccessfuly;
+    }
+
+    static TieredBuildStatus::TieredBuildStatus_t toTieredBuildStatus(TC::TieredCompilation::Status status)
+    {
+        switch(status){
+            case TC::TieredCompilation::Status::Pending : return TieredBuildStatus::pending;
+            case TC::TieredCompilation::Status::Ready : return TieredBuildStatus::ready;
+            case TC::TieredCompilation::Status::Failed : return TieredBuildStatus::failed;
+            default:
+                return TieredBuildStatus::unknown;
+        }
+    }
+
     CIF_PIMPL(IgcOclDeviceCtx) &globalState;
     CodeType::CodeType_t inType;
     CodeType::CodeType_t outType;
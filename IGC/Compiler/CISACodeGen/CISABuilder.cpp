@@ -4016,6 +4016,11 @@ namespace IGC
             ForceNonCoherentStatelessBti = ClContext->m_ShouldUseNonCoherentStatelessBTI;
             AllowSpill = !ClContext->m_InternalOptions.NoSpill;
 
+            if (ClContext->m_InternalOptions.TieredCompilation)
+            {
+                SaveOption(vISA_LinearScan, true);
+            }
+
             if (ClContext->m_Options.GTPinReRA)
             {
                 SaveOption(vISA_GTPinReRA, true);
@@ -6136,7 +6141,6 @@ namespace IGC
     {
         IGC_ASSERT(nullptr != m_program);
         CodeGenContext* const context = m_program->GetContext();
-        SProgramOutput* const pOutput = m_program->ProgramOutput();
         const std::vector<const char*>* additionalVISAAsmToLink = nullptr;
         bool emitVisaOnly = false;
 
@@ -6148,18 +6152,7 @@ namespace IGC
             emitVisaOnly = cl_context->m_InternalOptions.EmitVisaOnly;
         }
 
-        if (m_program->m_dispatchSize == SIMDMode::SIMD8)
-        {
-            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD8);
-        }
-        else if (m_program->m_dispatchSize == SIMDMode::SIMD16)
-        {
-            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD16);
-        }
-        else if (m_program->m_dispatchSize == SIMDMode::SIMD32)
-        {
-            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD32);
-        }
+        MemSnapshotBeforeCompile();
 
         VISAKernel* pMainKernel = nullptr;
 
@@ -6200,6 +6193,85 @@ namespace IGC
 
         COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
 
+        CollectCompileResults(pMainKernel, jitInfo, kernelName,
+            hasSymbolTable, emitVisaOnly, additionalVISAAsmToLink, pFGA);
+    }
+
+    void CEncoder::MemSnapshotBeforeCompile()
+    {
+        if (m_program->m_dispatchSize == SIMDMode::SIMD8)
+        {
+            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD8);
+        }
+        else if (m_program->m_dispatchSize == SIMDMode::SIMD16)
+        {
+            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD16);
+        }
+        else if (m_program->m_dispatchSize == SIMDMode::SIMD32)
+        {
+            MEM_SNAPSHOT(IGC::SMS_AFTER_CISACreateDestroy_SIMD32);
+        }
+    }
+
+    bool CEncoder::CanCompileAsync() const
+    {
+        CodeGenContext* const context = m_program->GetContext();
+        if (context->type == ShaderType::OPENCL_SHADER)
+        {
+            auto cl_context = static_cast<OpenCLProgramContext*>(context);
+            // -emit-visa-only looks at the compile status of the other SIMD
+            // variants before emitting the next one
+            if (!cl_context->m_VISAAsmToLink.empty() || cl_context->m_InternalOptions.EmitVisaOnly)
+            {
+                return false;
+            }
+        }
+        // Inline asm and vISA overrides are parsed through the (global) vISA
+        // text parser, keep those on the compiling thread.
+        return !m_hasInlineAsm && !m_isCodePatchCandidate && IGC_IS_FLAG_DISABLED(ShaderOverride);
+    }
+
+    void CEncoder::BeginAsyncCompile()
+    {
+        IGC_ASSERT(nullptr != m_program);
+        IGC_ASSERT(CanCompileAsync());
+
+        MemSnapshotBeforeCompile();
+
+        vISA::FINALIZER_INFO* jitInfo = nullptr;
+        vMainKernel->GetJitInfo(jitInfo);
+        jitInfo->stats.scratchSpaceSizeLimit = m_program->ProgramOutput()->m_scratchSpaceSizeLimit;
+        m_asyncCompileAsmName = m_enableVISAdump ? GetDumpFileName("isaasm") : "";
+
+        // The finalizer time is not accounted here, it runs on a worker thread
+        COMPILER_TIME_END(m_program->GetContext(), TIME_CG_vISACompile);
+    }
+
+    void CEncoder::FinalizeVISA()
+    {
+        m_vIsaCompileStatus = vbuilder->Compile(m_asyncCompileAsmName.c_str(), false);
+    }
+
+    void CEncoder::EndAsyncCompile(bool hasSymbolTable, GenXFunctionGroupAnalysis*& pFGA)
+    {
+        vISA::FINALIZER_INFO* jitInfo = nullptr;
+        vMainKernel->GetJitInfo(jitInfo);
+        CollectCompileResults(vMainKernel, jitInfo, "",
+            hasSymbolTable, false, nullptr, pFGA);
+    }
+
+    void CEncoder::CollectCompileResults(
+        VISAKernel* pMainKernel,
+        vISA::FINALIZER_INFO* jitInfo,
+        const std::string& kernelName,
+        bool hasSymbolTable,
+        bool emitVisaOnly,
+        const std::vector<const char*>* additionalVISAAsmToLink,
+        GenXFunctionGroupAnalysis*& pFGA)
+    {
+        CodeGenContext* const context = m_program->GetContext();
+        SProgramOutput* const pOutput = m_program->ProgramOutput();
+
 #if GET_TIME_STATS
         // handle the vISA time counters differently here
         if (context->m_compilerTimeStats)
@@ -6287,6 +6359,7 @@ namespace IGC
         m_program->m_staticCycle = jitInfo->stats.staticCycle;
         m_program->m_loopNestedStallCycle = jitInfo->stats.loopNestedStallCycle;
         m_program->m_loopNestedCycle = jitInfo->stats.loopNestedCycle;
+        m_program->m_cyclesPerWorkItem = jitInfo->stats.cyclesPerWorkItem;
 
         SetKernelRetryState(context, jitInfo, pFGA);
 
@@ -136,6 +136,15 @@ namespace IGC
         void MarkAsOutput(CVariable* var);
         void MarkAsPayloadLiveOut(CVariable* var);
         void Compile(bool hasSymbolTable, GenXFunctionGroupAnalysis*& pFGA);
+
+        /// Split version of Compile() used when the vISA finalization runs on
+        /// a worker thread (see VISACompileQueue). BeginAsyncCompile() and
+        /// EndAsyncCompile() must be called on the compiling thread, while
+        /// FinalizeVISA() only touches the vISA builder and may run anywhere.
+        bool CanCompileAsync() const;
+        void BeginAsyncCompile();
+        void FinalizeVISA();
+        void EndAsyncCompile(bool hasSymbolTable, GenXFunctionGroupAnalysis*& pFGA);
         std::string GetShaderName();
 
         CEncoder();
@@ -711,6 +720,15 @@ namespace IGC
             const std::vector<std::string> &visaOverrideFiles,
             const std::string kernelName);
 
+        void MemSnapshotBeforeCompile();
+
+        /// Read the results of vbuilder->Compile() back into the shader program
+        void CollectCompileResults(VISAKernel* pMainKernel,
+            vISA::FINALIZER_INFO* jitInfo, const std::string& kernelName,
+            bool hasSymbolTable, bool emitVisaOnly,
+            const std::vector<const char*>* additionalVISAAsmToLink,
+            GenXFunctionGroupAnalysis*& pFGA);
+
         // setup m_retryManager according to jitinfo and other factors
         void SetKernelRetryState(CodeGenContext* context, vISA::FINALIZER_INFO* jitInfo, GenXFunctionGroupAnalysis*& pFGA);
 
@@ -811,6 +829,8 @@ namespace IGC
 
         CShader* m_program;
         int m_vIsaCompileStatus = VISA_FAILURE;
+        /// .isaasm dump file name handed over to FinalizeVISA()
+        std::string m_asyncCompileAsmName;
 
         // Keep a map between a function and its per-function attributes needed for function pointer support
         struct FuncAttrib
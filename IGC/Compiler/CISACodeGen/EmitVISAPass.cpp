@@ -17,6 +17,7 @@ SPDX-License-Identifier: MIT
 #include "messageEncoding.hpp"
 #include "PayloadMapping.hpp"
 #include "VectorProcess.hpp"
+#include "VISACompileQueue.hpp"
 #include "ShaderCodeGen.hpp"
 #include "MemOpt.h"           // helper functions related struct value.
 #include "common/allocator.h"
@@ -24,6 +25,7 @@ SPDX-License-Identifier: MIT
 #include "common/debug/Dump.hpp"
 #include "common/igc_regkeys.hpp"
 #include "common/Stats.hpp"
+#include "common/TraceEvents.hpp"
 #include "Compiler/CISACodeGen/helper.h"
 #include "Compiler/DebugInfo/ScalarVISAModule.h"
 #include "common/secure_mem.h"
@@ -597,6 +599,36 @@ void EmitPass::CreateKernelShaderMap(CodeGenContext* ctx, MetaDataUtils* pMdUtil
     }
 }
 
+// The vISA of a kernel can be finalized on a worker thread when nothing emitted
+// afterwards depends on its results before the queue is drained.
+bool EmitPass::canCompileAsync() const
+{
+    return m_pCtx->m_VISACompileQueue &&
+        m_encoder->CanCompileAsync() &&
+        !m_pCtx->m_instrTypes.hasDebugInfo &&
+        !m_currShader->GetDebugInfoData().m_pDebugEmitter &&
+        IGC_IS_FLAG_DISABLED(ForceBestSIMD) &&
+        !IsStage1BestPerf(m_pCtx->m_CgFlag, m_pCtx->m_StagingCtx) &&
+        !IsStage1FastCompile(m_pCtx->m_CgFlag, m_pCtx->m_StagingCtx);
+}
+
+void EmitPass::setMidThreadPreemption(CShader* shader)
+{
+    if ((shader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
+        shader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
+        shader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
+        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
+        (shader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
+        (shader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
+    {
+
+        {
+            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(shader);
+            kernel->SetDisableMidthreadPreemption();
+        }
+    }
+}
+
 bool EmitPass::runOnFunction(llvm::Function& F)
 {
     m_currFuncHasSubroutine = false;
@@ -642,6 +674,9 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         return false;
     }
 
+    TraceEvents::Scope traceScope(
+        F.getName().str() + " SIMD" + std::to_string(numLanes(m_SimdMode)), "kernel");
+
     bool isDummyKernel = IGC::isIntelSymbolTableVoidProgram(&F);
     bool isFuncGroupHead = !m_FGA || m_FGA->isGroupHead(&F);
     bool hasStackCall = m_FGA && m_FGA->getGroup(&F) && m_FGA->getGroup(&F)->hasStackCall();
@@ -702,6 +737,10 @@ bool EmitPass::runOnFunction(llvm::Function& F)
     CShader* prevShader = m_pCtx->m_prevShader;
     if (isFuncGroupHead)
     {
+        if (m_pCtx->m_VISACompileQueue)
+        {
+            m_pCtx->m_VISACompileQueue->beginKernel(m_currShader->GetParent());
+        }
         m_currShader->InitEncoder(m_SimdMode, m_canAbortOnSpill, m_ShaderDispatchMode);
         // Pre-analysis pass to be executed before call to visa builder so we can pass scratch space offset
         m_currShader->PreAnalysisPass();
@@ -1266,6 +1305,7 @@ bool EmitPass::runOnFunction(llvm::Function& F)
             finalize = finalize && FG->checkSimdModeValid(m_SimdMode);
     }
     bool destroyVISABuilder = false;
+    bool compileAsync = false;
     if (finalize)
     {
         destroyVISABuilder = true;
@@ -1277,11 +1317,27 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         {
             compileWithSymbolTable = true;
         }
-        if (!skipPrologue)
+        compileAsync = !skipPrologue && canCompileAsync();
+        if (compileAsync)
+        {
+            // Hand the finalization over to a worker thread. The results are
+            // read back, and the builder destroyed, once it has finished.
+            CShader* shader = m_currShader;
+            GenXFunctionGroupAnalysis* FGA = m_FGA;
+            m_encoder->BeginAsyncCompile();
+            m_pCtx->m_VISACompileQueue->submit(shader->GetParent(),
+                [shader]() { shader->GetEncoder().FinalizeVISA(); },
+                [shader, compileWithSymbolTable, FGA]() mutable {
+                    shader->GetEncoder().EndAsyncCompile(compileWithSymbolTable, FGA);
+                    shader->GetEncoder().DestroyVISABuilder();
+                    setMidThreadPreemption(shader);
+                });
+        }
+        else if (!skipPrologue)
         {
             m_encoder->Compile(compileWithSymbolTable, m_FGA);
         }
-        m_pCtx->m_prevShader = m_currShader;
+        m_pCtx->m_prevShader = compileAsync ? nullptr : m_currShader;
     }
 
     if (destroyVISABuilder)
@@ -1291,10 +1347,13 @@ bool EmitPass::runOnFunction(llvm::Function& F)
             IDebugEmitter::Release(m_pDebugEmitter);
         }
 
-        if (!m_encoder->IsCodePatchCandidate() ||
+        // With compileAsync the builder is destroyed by the queue, once the
+        // results have been collected
+        if (!compileAsync &&
+            (!m_encoder->IsCodePatchCandidate() ||
             m_encoder->HasPrevKernel() ||
             !m_currShader->ProgramOutput()->m_programBin ||
-            m_currShader->ProgramOutput()->m_scratchSpaceUsedBySpills)
+            m_currShader->ProgramOutput()->m_scratchSpaceUsedBySpills))
         {
             m_pCtx->m_prevShader = nullptr;
             // Postpone destroying VISA builder to
@@ -1307,18 +1366,9 @@ bool EmitPass::runOnFunction(llvm::Function& F)
         }
     }
 
-    if ((m_currShader->GetShaderType() == ShaderType::COMPUTE_SHADER ||
-        m_currShader->GetShaderType() == ShaderType::OPENCL_SHADER) &&
-        m_currShader->m_Platform->supportDisableMidThreadPreemptionSwitch() &&
-        IGC_IS_FLAG_ENABLED(EnableDisableMidThreadPreemptionOpt) &&
-        (m_currShader->GetContext()->m_instrTypes.numLoopInsts == 0) &&
-        (m_currShader->ProgramOutput()->m_InstructionCount < IGC_GET_FLAG_VALUE(MidThreadPreemptionDisableThreshold)))
+    if (!compileAsync)
     {
-
-        {
-            COpenCLKernel* kernel = static_cast<COpenCLKernel*>(m_currShader);
-            kernel->SetDisableMidthreadPreemption();
-        }
+        setMidThreadPreemption(m_currShader);
     }
 
     if (IGC_IS_FLAG_ENABLED(ForceBestSIMD))
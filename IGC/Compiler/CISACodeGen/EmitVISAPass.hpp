@@ -726,6 +726,12 @@ public:
     /// check if symbol table is needed
     bool isSymbolTableRequired(llvm::Function* F);
 
+    /// check if the vISA finalization can be handed over to m_VISACompileQueue
+    bool canCompileAsync() const;
+
+    /// disable mid-thread preemption for short loop-free compute kernels
+    static void setMidThreadPreemption(CShader* shader);
+
     // Arithmetic operations with constant folding
     // Src0 and Src1 are the input operands
     // DstPrototype is a prototype of the result of operation and may be used for cloning to a new variable
@@ -783,7 +783,7 @@ void EstimateFunctionSize::performImplArgsAnalysis()
         if (!tmpHasImplicitArg) //The function doesn't have an implicit argument: skip
             continue;
         Node->HasImplicitArg = true;
-        static int cnt = 0;
+        thread_local int cnt = 0;
         const char* Name;
         if (Node->isLeaf())
             Name = "Leaf";
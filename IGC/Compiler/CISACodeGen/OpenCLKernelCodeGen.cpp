@@ -25,6 +25,7 @@ SPDX-License-Identifier: MIT
 #include "Compiler/Optimizer/OpenCLPasses/LocalBuffers/InlineLocalsResolution.hpp"
 #include "Compiler/Optimizer/OpenCLPasses/KernelArgs.hpp"
 #include "Compiler/CISACodeGen/EmitVISAPass.hpp"
+#include "Compiler/CISACodeGen/VISACompileQueue.hpp"
 #include "Compiler/Optimizer/OCLBIUtils.h"
 #include "AdaptorOCL/OCL/KernelAnnotations.hpp"
 #include "common/allocator.h"
@@ -454,6 +455,11 @@ namespace IGC
             CompileOneKernelAtTime = true;
         }
 
+        if (internalOptions.hasArg(OPT_tiered_compilation_common))
+        {
+            TieredCompilation = true;
+        }
+
         if (internalOptions.hasArg(OPT_skip_reloc_add_common))
         {
             AllowRelocAdd = false;
@@ -3673,6 +3679,51 @@ namespace IGC
         return result;
     }
 
+    // SIMD variants of a kernel are independent of each other only when all of
+    // them are sent to the runtime. Kernels are always independent, the ones
+    // looking at their other SIMD variants wait for them (see waitFor()).
+    static std::unique_ptr<VISACompileQueue> CreateVISACompileQueue(
+        OpenCLProgramContext* ctx, bool simdVariantsIndependent)
+    {
+        bool acrossKernels = IGC_IS_FLAG_ENABLED(EnableParallelKernelCompile);
+        if (!acrossKernels &&
+            !(simdVariantsIndependent && IGC_IS_FLAG_ENABLED(EnableParallelSIMDCompile)))
+        {
+            return nullptr;
+        }
+        auto compileQueue = std::make_unique<VISACompileQueue>(
+            IGC_GET_FLAG_VALUE(ParallelCompileThreads), acrossKernels);
+        ctx->m_VISACompileQueue = compileQueue.get();
+        return compileQueue;
+    }
+
+    // With SelectOCLSIMDByCycleEstimate, every allowed and profitable SIMD
+    // width of a kernel is compiled and the one vISA predicts to spend the
+    // fewest cycles per work-item is kept. The estimate does not account for
+    // spills, so variants that spill are not considered, nor are those without
+    // an estimate; if none is left, the usual widest-first choice applies.
+    static COpenCLKernel* selectSIMDByCycleEstimate(
+        OpenCLProgramContext* ctx, std::initializer_list<COpenCLKernel*> shaders)
+    {
+        if (IGC_IS_FLAG_DISABLED(SelectOCLSIMDByCycleEstimate) ||
+            ctx->m_DriverInfo.sendMultipleSIMDModes() ||
+            ctx->getModuleMetaData()->csInfo.forcedSIMDSize != 0)
+        {
+            return nullptr;
+        }
+        COpenCLKernel* best = nullptr;
+        for (auto shader : shaders)
+        {
+            if (!COpenCLKernel::IsValidShader(shader) || shader->m_cyclesPerWorkItem <= 0 ||
+                shader->m_spillSize > 0)
+                continue;
+            // Ties go to the variant listed first.
+            if (!best || shader->m_cyclesPerWorkItem < best->m_cyclesPerWorkItem)
+                best = shader;
+        }
+        return best;
+    }
+
     static void CodeGen(OpenCLProgramContext* ctx, CShaderProgram::KernelShaderMap& shaders)
     {
         COMPILER_TIME_START(ctx, TIME_CodeGen);
@@ -3704,9 +3755,15 @@ namespace IGC
                 pass1Mode = SIMDMode::SIMD16;
                 pass2Mode = SIMDMode::SIMD8;
             }
+            std::unique_ptr<VISACompileQueue> compileQueue = CreateVISACompileQueue(ctx, true);
+
             // Run first pass
             AddCodeGenPasses(*ctx, shaders, Passes, pass1Mode, false);
             Passes.run(*(ctx->getModule()));
+            if (compileQueue)
+            {
+                compileQueue->drain();
+            }
 
             // Create and run second pass
             IGCPassManager Passes2(ctx, "CG2");
@@ -3717,12 +3774,21 @@ namespace IGC
             AddCodeGenPasses(*ctx, shaders, Passes2, pass2Mode, false);
             COMPILER_TIME_END(ctx, TIME_CG_Add_Passes);
             Passes2.run(*(ctx->getModule()));
+            if (compileQueue)
+            {
+                compileQueue->drain();
+                ctx->m_VISACompileQueue = nullptr;
+            }
 
             COMPILER_TIME_END(ctx, TIME_CodeGen);
             DumpLLVMIR(ctx, "codegen");
             return;
         }
 
+        std::unique_ptr<VISACompileQueue> compileQueue =
+            CreateVISACompileQueue(ctx, ctx->m_DriverInfo.sendMultipleSIMDModes() ||
+                IGC_IS_FLAG_ENABLED(SelectOCLSIMDByCycleEstimate));
+
         if (ctx->m_DriverInfo.sendMultipleSIMDModes())
         {
             unsigned int leastSIMD = 8;
@@ -3778,6 +3844,11 @@ namespace IGC
         COMPILER_TIME_END(ctx, TIME_CG_Add_Passes);
 
         Passes.run(*(ctx->getModule()));
+        if (compileQueue)
+        {
+            compileQueue->drain();
+            ctx->m_VISACompileQueue = nullptr;
+        }
         COMPILER_TIME_END(ctx, TIME_CodeGen);
         DumpLLVMIR(ctx, "codegen");
     }
@@ -3878,6 +3949,11 @@ namespace IGC
                 else if (COpenCLKernel::IsVisaCompiledSuccessfullyForShader(simd8Shader))
                     GatherDataForDriver(ctx, simd8Shader, std::move(pKernel), pFunc, pMdUtils, SIMDMode::SIMD8);
             }
+            else if (COpenCLKernel* selected =
+                selectSIMDByCycleEstimate(ctx, { simd32Shader, simd16Shader, simd8Shader }))
+            {
+                GatherDataForDriver(ctx, selected, std::move(pKernel), pFunc, pMdUtils, selected->m_dispatchSize);
+            }
             else
             {
                 //Gather the kernel binary only for 1 SIMD mode of the kernel
@@ -4081,7 +4157,9 @@ namespace IGC
             }
         }
 
-        bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable;
+        // A tier-0 compile goes for a single SIMD width, like -O0 does
+        bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable ||
+            m_Context->m_InternalOptions.TieredCompilation;
 
         if (optDisable && simd_size == 0) // if simd size not requested in MD
         {
@@ -4188,13 +4266,28 @@ namespace IGC
 
         bool compileFunctionVariants = pCtx->m_enableSimdVariantCompilation &&
             (m_FGA && IGC::isIntelSymbolTableVoidProgram(m_FGA->getGroupHead(&F)));
+        bool tier0Compile = m_Context->m_InternalOptions.TieredCompilation;
+        bool canCompileMultipleSIMD = (pCtx->m_DriverInfo.sendMultipleSIMDModes() && !tier0Compile) ||
+            compileFunctionVariants;
+        // All the allowed SIMD widths that pass the profitability checks are
+        // compiled, and one is picked from their cycle estimates once they are
+        // done (see selectSIMDByCycleEstimate()).
+        bool selectByCycleEstimate = IGC_IS_FLAG_ENABLED(SelectOCLSIMDByCycleEstimate) &&
+            !compileFunctionVariants && !tier0Compile;
+        canCompileMultipleSIMD |= selectByCycleEstimate;
+
+        // The other SIMD variants may still be finalized in the background
+        if (pCtx->m_VISACompileQueue &&
+            !(canCompileMultipleSIMD && (pCtx->getModuleMetaData()->csInfo.forcedSIMDSize == 0)))
+        {
+            pCtx->m_VISACompileQueue->waitFor(m_parent);
+        }
 
         // Here we see if we have compiled a size for this shader already
         if ((simd8Program && simd8Program->ProgramOutput()->m_programSize > 0) ||
             (simd16Program && simd16Program->ProgramOutput()->m_programSize > 0) ||
             (simd32Program && simd32Program->ProgramOutput()->m_programSize > 0))
         {
-            bool canCompileMultipleSIMD = pCtx->m_DriverInfo.sendMultipleSIMDModes() || compileFunctionVariants;
             if (!(canCompileMultipleSIMD && (pCtx->getModuleMetaData()->csInfo.forcedSIMDSize == 0)))
                 return SIMDStatus::SIMD_FUNC_FAIL;
         }
@@ -4371,7 +4464,8 @@ namespace IGC
             // Here we check profitablility, etc.
             if (simdMode == SIMDMode::SIMD16)
             {
-                bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable;
+                bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable ||
+                    m_Context->m_InternalOptions.TieredCompilation;
 
                 if (optDisable)
                 {
@@ -4388,7 +4482,8 @@ namespace IGC
             }
             if (simdMode == SIMDMode::SIMD32)
             {
-                bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable;
+                bool optDisable = this->GetContext()->getModuleMetaData()->compOpt.OptDisable ||
+                    m_Context->m_InternalOptions.TieredCompilation;
 
                 if (optDisable)
                 {
@@ -66,6 +66,10 @@ namespace IGC
             bool DisableNoMaskWA                            = false;
             bool IgnoreBFRounding                           = false;   // If true, ignore BFloat rounding when folding bf operations
             bool CompileOneKernelAtTime                     = false;
+            // Quick tier-0 compile of a tiered build: minimal optimization
+            // pipeline, a single SIMD width and linear scan RA. The optimized
+            // binary is built in the background (see AdaptorOCL/TieredCompilation.hpp).
+            bool TieredCompilation                          = false;
 
             // Generic address related
             bool ForceGlobalMemoryAllocation                = false;
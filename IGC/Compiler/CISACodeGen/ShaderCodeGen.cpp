@@ -1379,7 +1379,9 @@ void OptimizeIR(CodeGenContext* const pContext)
                                IGC_GET_FLAG_VALUE(ForceFastestSIMD)) &&
                              ((IGC_GET_FLAG_VALUE(FastestS1Experiments) & FCEXP_DISABLE_GOPT) ||
                                IGC_GET_FLAG_VALUE(FastestS1Experiments) == FCEXP_NO_EXPRIMENT ||
-                               pContext->getModuleMetaData()->compOpt.DisableFastestGopt));
+                               pContext->getModuleMetaData()->compOpt.DisableFastestGopt)) ||
+                           (pContext->type == ShaderType::OPENCL_SHADER &&
+                               static_cast<OpenCLProgramContext*>(pContext)->m_InternalOptions.TieredCompilation);
 
         if (pContext->m_instrTypes.hasMultipleBB && !disableGOPT)
         {
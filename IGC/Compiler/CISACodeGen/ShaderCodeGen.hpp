@@ -337,6 +337,7 @@ public:
     void        GetPayloadElementSymbols(llvm::Value* inst, CVariable* payload[], int vecWidth);
 
     CodeGenContext* GetContext() const { return m_ctx; }
+    CShaderProgram* GetParent() const { return m_parent; }
 
     SProgramOutput* ProgramOutput();
 
@@ -389,6 +390,7 @@ public:
     uint m_staticCycle = 0;
     uint m_loopNestedStallCycle = 0;
     uint m_loopNestedCycle= 0;
+    float m_cyclesPerWorkItem = 0;  // vISA throughput estimate, 0 if unknown
     unsigned m_spillSize = 0;
     float m_spillCost = 0;          // num weighted spill inst / total inst
     uint m_asmInstrCount = 0;
@@ -0,0 +1,89 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "Compiler/CISACodeGen/VISACompileQueue.hpp"
+#include "llvmWrapper/Support/ThreadPool.h"
+#include "Probe/Assertion.h"
+#include "common/igc_regkeys.hpp"
+#include <algorithm>
+#include <thread>
+
+using namespace IGC;
+
+VISACompileQueue::VISACompileQueue(unsigned numThreads, bool acrossKernels)
+    : m_pool(IGCLLVM::createThreadPool(numThreads)),
+      m_acrossKernels(acrossKernels)
+{
+    unsigned workers = numThreads ? numThreads : std::thread::hardware_concurrency();
+    m_maxPending = 2 * std::max(1u, workers);
+}
+
+VISACompileQueue::~VISACompileQueue()
+{
+    IGC_ASSERT_MESSAGE(m_pending.empty(), "vISA compile queue destroyed with pending work");
+    m_pool->wait();
+}
+
+void VISACompileQueue::submit(CShaderProgram* kernel,
+    std::function<void()> finalize,
+    std::function<void()> complete)
+{
+    PendingCompile pending;
+    pending.kernel = kernel;
+    // The pool threads run on the keys and the shader hash of the
+    // compilation that submits.
+    pending.finalized = m_pool->async(
+        [context = GetThreadRegKeysContext(), finalize = std::move(finalize)]() {
+            RegKeysScope scope(context);
+            finalize();
+        });
+    pending.complete = std::move(complete);
+    m_pending.push_back(std::move(pending));
+}
+
+void VISACompileQueue::completeFront()
+{
+    PendingCompile pending = std::move(m_pending.front());
+    m_pending.pop_front();
+    pending.finalized.wait();
+    pending.complete();
+}
+
+void VISACompileQueue::drain()
+{
+    while (!m_pending.empty())
+    {
+        completeFront();
+    }
+}
+
+void VISACompileQueue::beginKernel(const CShaderProgram* kernel)
+{
+    if (!m_acrossKernels)
+    {
+        if (!m_pending.empty() && m_pending.front().kernel != kernel)
+        {
+            drain();
+        }
+        return;
+    }
+    while (m_pending.size() >= m_maxPending)
+    {
+        completeFront();
+    }
+}
+
+void VISACompileQueue::waitFor(const CShaderProgram* kernel)
+{
+    auto last = std::find_if(m_pending.rbegin(), m_pending.rend(),
+        [kernel](const PendingCompile& pending) { return pending.kernel == kernel; });
+    for (size_t n = std::distance(last, m_pending.rend()); n > 0; --n)
+    {
+        completeFront();
+    }
+}
@@ -0,0 +1,81 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/Support/ThreadPool.h>
+#include "common/LLVMWarningsPop.hpp"
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace IGC
+{
+    class CShaderProgram;
+
+    /// Runs vISA finalization (RA, scheduling, encoding) of kernels on a pool
+    /// of worker threads while EmitPass keeps emitting the next ones.
+    ///
+    /// The finalize task given to submit() may only touch the vISA builder
+    /// it works on. Everything that reads the results back into the shader
+    /// or the CodeGenContext is done by the complete callback, which always
+    /// runs on the compiling thread and in submission order, so the output
+    /// does not depend on how the workers get scheduled.
+    ///
+    /// By default only the SIMD variants of one kernel are in flight at a
+    /// time. With acrossKernels, compiles of different kernels overlap too;
+    /// the number of pending compiles (and so of live vISA builders) is then
+    /// bounded to a few per worker thread.
+    class VISACompileQueue
+    {
+    public:
+        VISACompileQueue(unsigned numThreads, bool acrossKernels = false);
+        ~VISACompileQueue();
+
+        VISACompileQueue(const VISACompileQueue&) = delete;
+        VISACompileQueue& operator=(const VISACompileQueue&) = delete;
+
+        /// Start \p finalize on a worker thread. \p complete is called later
+        /// from drain(), after \p finalize has finished.
+        void submit(CShaderProgram* kernel,
+            std::function<void()> finalize,
+            std::function<void()> complete);
+
+        /// Wait for every pending compile and complete them in order.
+        void drain();
+
+        /// Called before the vISA of \p kernel is emitted. Unless compiles
+        /// across kernels are allowed, a kernel is not started before the
+        /// previous one has been completed.
+        void beginKernel(const CShaderProgram* kernel);
+
+        /// Complete every pending compile of \p kernel (and the ones
+        /// submitted before them), for code reading the outputs of its other
+        /// SIMD variants.
+        void waitFor(const CShaderProgram* kernel);
+
+        bool empty() const { return m_pending.empty(); }
+
+    private:
+        struct PendingCompile
+        {
+            CShaderProgram* kernel;
+            std::shared_future<void> finalized;
+            std::function<void()> complete;
+        };
+
+        void completeFront();
+
+        std::unique_ptr<llvm::ThreadPool> m_pool;
+        std::deque<PendingCompile> m_pending;
+        bool m_acrossKernels;
+        size_t m_maxPending;
+    };
+}
@@ -58,9 +58,6 @@ WIAnalysis::WIAnalysis() : FunctionPass(ID)
 
 const unsigned int WIAnalysisRunner::MinIndexBitwidthToPreserve = 16;
 
-// For dumpping WIA info per each invocation
-DenseMap<const Function*, int> WIAnalysisRunner::m_funcInvocationId;
-
 /// Define shorter names for dependencies, for clarity of the conversion maps
 /// Note that only UGL/UWG/UTH/RND are supported.
 #define UGL WIAnalysis::UNIFORM_GLOBAL
@@ -185,6 +182,9 @@ void WIAnalysisRunner::print(raw_ostream& OS, const Module*) const
     ss << "WIAnalysis: " << m_func->getName().str();
     Banner(OS, ss.str());
 
+    if (m_restoredFromCache)
+        OS << "Reused from the WIAnalysis cache\n";
+
     OS << "Args: \n";
     for (Function::arg_iterator I = m_func->arg_begin(), E = m_func->arg_end();
         I != E; ++I) {
@@ -246,7 +246,7 @@ void WIAnalysisRunner::lock_print()
 {
     IGC::Debug::DumpLock();
     {
-        int id = m_funcInvocationId[m_func]++;
+        int id = m_CGCtx->m_WIAnalysisInvocationId[m_func]++;
         std::stringstream ss;
         ss << m_func->getName().str() << "_WIAnalysis_" << id;
         auto name =
@@ -315,7 +315,7 @@ bool WIAnalysisRunner::run()
 
     updateArgsDependency(&F);
 
-    if (!IGC_IS_FLAG_ENABLED(DisableUniformAnalysis))
+    if (!IGC_IS_FLAG_ENABLED(DisableUniformAnalysis) && !restoreFromCache())
     {
         // Compute the  first iteration of the WI-dep according to ordering
         // instructions this ordering is generally good (as it ususally correlates
@@ -361,6 +361,8 @@ bool WIAnalysisRunner::run()
                 }
             }
         }
+
+        saveToCache();
     }
 
     if (IGC_IS_FLAG_ENABLED(DumpWIA))
@@ -378,6 +380,161 @@ bool WIAnalysisRunner::run()
     return false;
 }
 
+bool WIAnalysisRunner::restoreFromCache()
+{
+    m_signature.clear();
+    if (!m_CGCtx || IGC_IS_FLAG_DISABLED(EnableWIAnalysisCache))
+        return false;
+
+    // The arguments have their dependency already, which carries everything
+    // the results depend on from the metadata. The rest comes from the
+    // function itself. Values are identified by address, the cache drops the
+    // entry once one of them is deleted or replaced.
+    auto& F = *m_func;
+    m_signature.push_back(reinterpret_cast<uintptr_t>(&F));
+    m_signature.push_back(F.hasFnAttribute("KMPLOCK"));
+    for (auto& Arg : F.args())
+    {
+        m_signature.push_back(reinterpret_cast<uintptr_t>(&Arg));
+        m_signature.push_back(reinterpret_cast<uintptr_t>(Arg.getType()));
+        m_signature.push_back(m_depMap.GetAttributeWithoutCreating(&Arg));
+    }
+    for (auto& BB : F)
+    {
+        m_signature.push_back(reinterpret_cast<uintptr_t>(&BB));
+        for (auto& I : BB)
+        {
+            m_signature.push_back(reinterpret_cast<uintptr_t>(&I));
+            m_signature.push_back(I.getOpcode());
+            m_signature.push_back(reinterpret_cast<uintptr_t>(I.getType()));
+            m_signature.push_back(I.getNumOperands());
+            for (const Use& Op : I.operands())
+                m_signature.push_back(reinterpret_cast<uintptr_t>(Op.get()));
+            if (auto* Phi = dyn_cast<PHINode>(&I))
+            {
+                for (const BasicBlock* Pred : Phi->blocks())
+                    m_signature.push_back(reinterpret_cast<uintptr_t>(Pred));
+            }
+        }
+    }
+
+    const WIAnalysisCache::Entry* E = m_CGCtx->getWIAnalysisCache().lookup(&F, m_signature);
+    if (!E)
+        return false;
+
+    for (auto& Dep : E->Deps)
+        m_depMap.SetAttribute(Dep.first, Dep.second);
+    for (auto& Branches : E->CtrlBranches)
+    {
+        auto& Set = m_ctrlBranches[Branches.first];
+        Set.insert(Branches.second.begin(), Branches.second.end());
+    }
+    for (auto& A : E->Allocas)
+    {
+        AllocaDep& Dep = m_allocaDepMap[A.Alloca];
+        Dep.stores = A.Stores;
+        Dep.lifetimes = A.Lifetimes;
+        Dep.assume_uniform = A.AssumeUniform;
+        for (const StoreInst* St : A.Stores)
+            m_storeDepMap.insert(std::make_pair(St, A.Alloca));
+    }
+    m_restoredFromCache = true;
+    return true;
+}
+
+void WIAnalysisRunner::saveToCache()
+{
+    if (m_signature.empty())
+        return;
+
+    auto& F = *m_func;
+    auto E = std::make_unique<WIAnalysisCache::Entry>();
+    // The arguments are part of the signature, with their dependency.
+    for (auto& I : instructions(F))
+    {
+        if (hasDependency(&I))
+            E->Deps.emplace_back(&I, m_depMap.GetAttributeWithoutCreating(&I));
+    }
+    for (auto& Branches : m_ctrlBranches)
+    {
+        E->CtrlBranches.emplace_back(Branches.first,
+            std::vector<const Instruction*>(Branches.second.begin(), Branches.second.end()));
+    }
+    for (auto& A : m_allocaDepMap)
+    {
+        E->Allocas.push_back(
+            { A.first, A.second.stores, A.second.lifetimes, A.second.assume_uniform });
+    }
+    E->Signature = std::move(m_signature);
+    m_signature.clear();
+    m_CGCtx->getWIAnalysisCache().insert(&F, std::move(E));
+}
+
+const WIAnalysisCache::Entry* WIAnalysisCache::lookup(
+    const llvm::Function* F, const std::vector<uintptr_t>& Signature)
+{
+    FunctionStats& Stats = m_stats[F->getName()];
+    ++Stats.Runs;
+    auto It = m_entries.find(F);
+    if (It == m_entries.end())
+        return nullptr;
+    if (!It->second->Valid || It->second->Signature != Signature)
+    {
+        ++Stats.Changed;
+        m_entries.erase(It);
+        return nullptr;
+    }
+    ++Stats.Reused;
+    return It->second.get();
+}
+
+void WIAnalysisCache::insert(llvm::Function* F, std::unique_ptr<Entry> E)
+{
+    // The signature refers to the function, its arguments, blocks and
+    // instructions, and the operands of the instructions.
+    llvm::DenseSet<Value*> Values;
+    Values.insert(F);
+    for (auto& Arg : F->args())
+        Values.insert(&Arg);
+    for (auto& BB : *F)
+    {
+        Values.insert(&BB);
+        for (auto& I : BB)
+        {
+            Values.insert(&I);
+            for (Value* Op : I.operands())
+            {
+                if (Op)
+                    Values.insert(Op);
+            }
+        }
+    }
+    E->Watched.reserve(Values.size());
+    for (Value* V : Values)
+        E->Watched.emplace_back(V, E.get());
+    m_entries[F] = std::move(E);
+}
+
+void WIAnalysisCache::print(llvm::raw_ostream& OS) const
+{
+    FunctionStats Total;
+    for (auto& Stats : m_stats)
+    {
+        Total.Runs += Stats.second.Runs;
+        Total.Reused += Stats.second.Reused;
+        Total.Changed += Stats.second.Changed;
+    }
+    OS << "WIAnalysis cache: " << Total.Runs << " runs, " << Total.Reused
+       << " recomputations avoided, " << Total.Changed
+       << " recomputed after a change\n";
+    for (auto& Stats : m_stats)
+    {
+        OS << "  " << Stats.first() << ": " << Stats.second.Runs << " runs, "
+           << Stats.second.Reused << " reused, " << Stats.second.Changed
+           << " changed\n";
+    }
+}
+
 bool WIAnalysis::runOnFunction(Function& F)
 {
     auto* MDUtils = getAnalysis<MetaDataUtilsWrapper>().getMetaDataUtils();
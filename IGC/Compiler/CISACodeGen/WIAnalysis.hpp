@@ -23,14 +23,17 @@ SPDX-License-Identifier: MIT
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
 #include <llvm/ADT/SmallSet.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
+#include <llvm/IR/ValueHandle.h>
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Dominators.h>
 #include <llvm/Analysis/LoopInfo.h>
 #include <llvm/Analysis/PostDominators.h>
 #include "common/LLVMWarningsPop.hpp"
 
+#include <memory>
 #include <vector>
 #include <common/Types.hpp>
 
@@ -67,6 +70,90 @@ namespace IGC
         static inline WIBaseClass::WIDependancy getEmptyAttribute() { return WIBaseClass::INVALID; }
     };
 
+    /// @brief Results of the WIAnalysis runs of a compilation, kept on the
+    ///  CodeGenContext per function. The analysis is run again by many passes
+    ///  that do not preserve it, often on functions nothing has changed in
+    ///  since. A run whose function still has the signature recorded by the
+    ///  previous run takes its results from here instead of recomputing them.
+    ///
+    ///  The signature identifies values by address. Every value it refers to
+    ///  is watched, and the entry is dropped when one of them is deleted or
+    ///  replaced, so that an address can't stand for another value.
+    class WIAnalysisCache
+    {
+    public:
+        struct Entry;
+
+        /// Marks its entry stale when the value is deleted or replaced.
+        class EntryVH final : public llvm::CallbackVH
+        {
+        public:
+            EntryVH(llvm::Value* V, Entry* E) : llvm::CallbackVH(V), m_Entry(E) {}
+
+        private:
+            void deleted() override
+            {
+                m_Entry->Valid = false;
+                setValPtr(nullptr);
+            }
+            void allUsesReplacedWith(llvm::Value*) override
+            {
+                m_Entry->Valid = false;
+            }
+
+            Entry* m_Entry;
+        };
+
+        struct Entry
+        {
+            /// Everything the results depend on: the arguments and their
+            /// dependency, the blocks and, for every instruction, its
+            /// opcode, type and operands.
+            std::vector<uintptr_t> Signature;
+            /// The values of the signature.
+            std::vector<EntryVH> Watched;
+            bool Valid = true;
+            std::vector<std::pair<const llvm::Instruction*, WIBaseClass::WIDependancy>> Deps;
+            std::vector<std::pair<const llvm::BasicBlock*, std::vector<const llvm::Instruction*>>> CtrlBranches;
+            /// The allocas whose stores the run tracked, from which the
+            /// incremental updates find what to recompute.
+            struct AllocaStores
+            {
+                const llvm::AllocaInst* Alloca;
+                std::vector<const llvm::StoreInst*> Stores;
+                std::vector<const llvm::IntrinsicInst*> Lifetimes;
+                bool AssumeUniform;
+            };
+            std::vector<AllocaStores> Allocas;
+        };
+
+        /// Returns the results of the previous run on F if it had the same
+        /// signature and none of its values went away, nullptr otherwise.
+        const Entry* lookup(const llvm::Function* F, const std::vector<uintptr_t>& Signature);
+        /// Records E, which watches the values of its signature from then on.
+        void insert(llvm::Function* F, std::unique_ptr<Entry> E);
+
+        /// Drops all the results, for when the module they refer to goes away.
+        void clear() { m_entries.clear(); }
+
+        /// Prints how many runs took their results from the cache.
+        void print(llvm::raw_ostream& OS) const;
+        bool empty() const { return m_stats.empty(); }
+
+    private:
+        struct FunctionStats
+        {
+            unsigned Runs = 0;
+            unsigned Reused = 0;
+            unsigned Changed = 0;
+        };
+
+        // Not moved by rehashes, for the handles to keep their entry.
+        llvm::DenseMap<const llvm::Function*, std::unique_ptr<Entry>> m_entries;
+        // By function name, so that the report outlives the module.
+        llvm::StringMap<FunctionStats> m_stats;
+    };
+
     class WIAnalysisRunner
     {
     public:
@@ -138,6 +225,8 @@ namespace IGC
             m_storeDepMap.clear();
             m_depMap.clear();
             m_forcedUniforms.clear();
+            m_signature.clear();
+            m_restoredFromCache = false;
         }
 
         /// print - print m_deps in human readable form
@@ -165,6 +254,14 @@ namespace IGC
         /// @brief mark the arguments dependency based on the metadata set
         void updateArgsDependency(llvm::Function* pF);
 
+        /// @brief take the results of a previous run from the cache of the
+        ///        context if the function has not changed since
+        /// @return true if the results were restored
+        bool restoreFromCache();
+
+        /// @brief record the results of this run in the cache of the context
+        void saveToCache();
+
         /*! \name Dependency Calculation Functions
          *  \{ */
          /// @brief Calculate the dependency type for the instruction
@@ -289,8 +386,11 @@ namespace IGC
 
         IGC::FastValueMap<WIBaseClass::WIDependancy, FastValueMapAttributeInfo<WIBaseClass::WIDependancy>> m_depMap;
 
-        // For dumpping WIA info per each invocation
-        static llvm::DenseMap<const llvm::Function*, int> m_funcInvocationId;
+        /// Signature of the function computed by restoreFromCache, or empty
+        /// if the cache is not used.
+        std::vector<uintptr_t> m_signature;
+        /// The results were taken from the cache.
+        bool m_restoredFromCache = false;
     };
 
     /// @brief Work Item Analysis class used to provide information on
@@ -15,6 +15,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 #include "Compiler/CISACodeGen/ShaderCodeGen.hpp"
 #include "Compiler/CISACodeGen/OpenCLKernelCodeGen.hpp"
+#include "Compiler/CISACodeGen/WIAnalysis.hpp"
 #include "Compiler/CodeGenPublic.h"
 #include "Probe/Assertion.h"
 
@@ -390,6 +391,8 @@ namespace IGC
 
     void CodeGenContext::setModule(llvm::Module* m)
     {
+        if (m_WIAnalysisCache)
+            m_WIAnalysisCache->clear();
         module = (IGCLLVM::Module*)m;
         m_pMdUtils = new IGC::IGCMD::MetaDataUtils(m);
         modMD = new IGC::ModuleMetaData();
@@ -402,6 +405,8 @@ namespace IGC
     // delete in order to prevent deleting dangling pointers happening.
     void CodeGenContext::deleteModule()
     {
+        if (m_WIAnalysisCache)
+            m_WIAnalysisCache->clear();
         delete m_pMdUtils;
         delete modMD;
         delete module;
@@ -412,6 +417,13 @@ namespace IGC
         annotater = nullptr;
     }
 
+    WIAnalysisCache& CodeGenContext::getWIAnalysisCache()
+    {
+        if (!m_WIAnalysisCache)
+            m_WIAnalysisCache = new WIAnalysisCache();
+        return *m_WIAnalysisCache;
+    }
+
     IGC::ModuleMetaData* CodeGenContext::getModuleMetaData() const
     {
         IGC_ASSERT_MESSAGE(nullptr != modMD, "Module Metadata is not initialized");
@@ -503,12 +515,29 @@ namespace IGC
 
     CodeGenContext::~CodeGenContext()
     {
+        if (m_WIAnalysisCache)
+        {
+            if (IGC_IS_FLAG_ENABLED(DumpWIAnalysisCacheStats) && !m_WIAnalysisCache->empty())
+            {
+                auto name =
+                    IGC::Debug::DumpName(IGC::Debug::GetShaderOutputName())
+                    .Hash(hash)
+                    .Type(type)
+                    .Pass("WIAnalysisCache")
+                    .Extension("txt");
+                m_WIAnalysisCache->print(IGC::Debug::Dump(name, IGC::Debug::DumpType::DBG_MSG_TEXT).stream());
+            }
+            delete m_WIAnalysisCache;
+            m_WIAnalysisCache = nullptr;
+        }
         clear();
     }
 
 
     void CodeGenContext::clear()
     {
+        if (m_WIAnalysisCache)
+            m_WIAnalysisCache->clear();
         m_enableSubroutine = false;
         m_enableFunctionPointer = false;
 
@@ -87,6 +87,8 @@ namespace IGCOpts
 namespace IGC
 {
     class CodeGenContext;
+    class VISACompileQueue;
+    class WIAnalysisCache;
 
     struct SProgramOutput
     {
@@ -915,8 +917,16 @@ namespace IGC
         // Record previous simd for code patching
         CShader* m_prevShader = nullptr;
 
+        // Set while code generation hands vISA finalization over to worker threads
+        VISACompileQueue* m_VISACompileQueue = nullptr;
+
         // For IR dump after pass
         unsigned     m_numPasses = 0;
+        // For WIAnalysis dumps, number of times each function was analyzed
+        llvm::DenseMap<const llvm::Function*, int> m_WIAnalysisInvocationId;
+        // Results of the WIAnalysis runs on the functions of the module,
+        // created by the first run
+        WIAnalysisCache* m_WIAnalysisCache = nullptr;
         bool m_threadCombiningOptDone = false;
 
         void* m_ConstantBufferReplaceShaderPatterns = nullptr;
@@ -1043,6 +1053,7 @@ namespace IGC
         // delete in order to prevent deleting dangling pointers happening.
         void deleteModule();
         IGC::ModuleMetaData* getModuleMetaData() const;
+        WIAnalysisCache& getWIAnalysisCache();
         unsigned int getRegisterPointerSizeInBits(unsigned int AS) const;
         bool enableFunctionCall() const;
         void CheckEnableSubroutine(llvm::Module& M);
@@ -0,0 +1,95 @@
+;=========================== begin_copyright_notice ============================
+;
+; Copyright (C) 2024 Intel Corporation
+;
+; SPDX-License-Identifier: MIT
+;
+;============================ end_copyright_notice =============================
+;
+; REQUIRES: regkeys
+;
+; RUN: igc_opt -regkey PrintToConsole=1 -print-wia-check -annotate_uniform_allocas -annotate_uniform_allocas -S < %s 2>&1 | FileCheck %s --check-prefixes=CHECK,CACHE
+; RUN: igc_opt -regkey PrintToConsole=1 -regkey EnableWIAnalysisCache=0 -print-wia-check -annotate_uniform_allocas -annotate_uniform_allocas -S < %s 2>&1 | FileCheck %s --check-prefixes=CHECK,NOCACHE
+; RUN: igc_opt -regkey PrintToConsole=1 -print-wia-check -annotate_uniform_allocas -instcombine -annotate_uniform_allocas -S < %s 2>&1 | FileCheck %s --check-prefix=CHANGED
+; ------------------------------------------------
+; WIAnalysis cache
+; ------------------------------------------------
+;
+; AnnotateUniformAllocas does not preserve WIAnalysis, so WIAnalysis is run
+; once for each of the two passes. The first pass only adds metadata, so with
+; the cache the second run takes its results from the first one. They have to
+; be the same as those computed from scratch, including the allocas whose
+; uniformity depends on their stores and on divergent branches.
+;
+; In between the two runs, instcombine replaces %m by %p and deletes it. The
+; cached results refer to %m, so the second run recomputes them.
+
+; CHECK-LABEL: WIAnalysis: test
+; CHECK-NOT: Reused from the WIAnalysis cache
+; CHECK: uniform_{{[a-z]+}} {{.*}}%u = alloca i32
+; CHECK: random {{.*}}%r = alloca i32
+; CHECK: random {{.*}}%d = alloca i32
+; CHECK: random {{.*}}%cmp = icmp
+; CHECK: random {{.*}}%p = phi
+; CHECK-LABEL: WIAnalysis: test
+; CACHE: Reused from the WIAnalysis cache
+; NOCACHE-NOT: Reused from the WIAnalysis cache
+; CHECK: uniform_{{[a-z]+}} {{.*}}%u = alloca i32
+; CHECK: random {{.*}}%r = alloca i32
+; CHECK: random {{.*}}%d = alloca i32
+; CHECK: random {{.*}}%cmp = icmp
+; CHECK: random {{.*}}%p = phi
+
+; CHANGED-LABEL: WIAnalysis: test
+; CHANGED: random {{.*}}%m = mul i32
+; CHANGED-LABEL: WIAnalysis: test
+; CHANGED-NOT: Reused from the WIAnalysis cache
+; CHANGED: uniform_{{[a-z]+}} {{.*}}%u = alloca i32
+; CHANGED: random {{.*}}%r = alloca i32
+; CHANGED: random {{.*}}%d = alloca i32
+; CHANGED: random {{.*}}%p = phi
+; CHANGED-NOT: %m = mul
+; CHANGED: random {{.*}}%s2 = add i32
+
+; CHECK-LABEL: define spir_kernel void @test(
+; CHECK: %u = alloca i32, align 4, !uniform
+; CHECK-NOT: %r = alloca i32, align 4, !uniform
+; CHECK-NOT: %d = alloca i32, align 4, !uniform
+
+define spir_kernel void @test(i32 %a, i32 addrspace(1)* %out) {
+entry:
+  %u = alloca i32, align 4
+  %r = alloca i32, align 4
+  %d = alloca i32, align 4
+  %lid = call i16 @llvm.genx.GenISA.getLocalID.X()
+  %lid32 = zext i16 %lid to i32
+  store i32 13, i32* %u
+  store i32 %lid32, i32* %r
+  store i32 0, i32* %d
+  %cmp = icmp ult i32 %lid32, %a
+  br i1 %cmp, label %then, label %exit
+
+then:
+  %x = add i32 %a, 1
+  store i32 7, i32* %d
+  br label %exit
+
+exit:
+  %p = phi i32 [ %a, %entry ], [ %x, %then ]
+  %lu = load i32, i32* %u
+  %lr = load i32, i32* %r
+  %ld = load i32, i32* %d
+  %s0 = add i32 %lu, %lr
+  %s1 = add i32 %s0, %ld
+  %m = mul i32 %p, 1
+  %s2 = add i32 %s1, %m
+  store i32 %s2, i32 addrspace(1)* %out
+  ret void
+}
+
+declare i16 @llvm.genx.GenISA.getLocalID.X()
+
+!igc.functions = !{!0}
+!0 = !{void (i32, i32 addrspace(1)*)* @test, !1}
+!1 = !{!2}
+!2 = !{!"function_type", i32 0}
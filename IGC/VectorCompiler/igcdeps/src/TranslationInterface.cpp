@@ -304,6 +304,7 @@ static void adjustTransformationsAndOptimizations(vc::CompileOptions &Opts) {
     Opts.ForceLoopUnrollThreshold = LoopUnrollThreshold;
   if (IGC_IS_FLAG_ENABLED(VCIgnoreLoopUnrollThresholdOnPragma))
     Opts.IgnoreLoopUnrollThresholdOnPragma = true;
+  Opts.FinalizerThreads = IGC_GET_FLAG_VALUE(VCFinalizeThreads);
 
   unsigned SIMDWidth = IGC_GET_FLAG_VALUE(ForceOCLSIMDWidth);
   if (SIMDWidth == 8 || SIMDWidth == 16 || SIMDWidth == 32)
@@ -152,6 +152,7 @@ struct CompileOptions {
   unsigned ForceLoopUnrollThreshold = 0;
   bool IgnoreLoopUnrollThresholdOnPragma = false;
   unsigned InteropSubgroupSize = 16;
+  unsigned FinalizerThreads = 0;
 
   bool CheckGVClobbering = false;
 
@@ -179,6 +179,10 @@ struct GenXBackendOptions {
   // Compile until vISA stage only.
   bool EmitVisaOnly = false;
 
+  // Number of threads the finalizer compiles the function groups of the
+  // module on. Values 0 and 1 compile them one after another.
+  unsigned FinalizerThreads = 0;
+
   bool EnableHashMovs = false;
   bool EnableHashMovsAtPrologue = false;
   uint64_t AsmHash = 0;
@@ -364,6 +368,8 @@ public:
 
   bool emitVisaOnly() const { return Options.EmitVisaOnly; }
 
+  unsigned getFinalizerThreads() const { return Options.FinalizerThreads; }
+
   unsigned getLoopUnrollThreshold() const {
     return Options.LoopUnrollThreshold;
   }
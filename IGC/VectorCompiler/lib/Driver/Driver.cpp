@@ -259,6 +259,7 @@ static GenXBackendOptions createBackendOptions(const vc::CompileOptions &Opts) {
   BackendOpts.LoopUnrollThreshold = Opts.ForceLoopUnrollThreshold;
   BackendOpts.IgnoreLoopUnrollThresholdOnPragma =
       Opts.IgnoreLoopUnrollThresholdOnPragma;
+  BackendOpts.FinalizerThreads = Opts.FinalizerThreads;
 
   if (Opts.InteropSubgroupSize)
     BackendOpts.InteropSubgroupSize = Opts.InteropSubgroupSize;
@@ -119,6 +119,7 @@ ModulePass *createGenXLiveRangesWrapperPass();
 ModulePass *createGenXRematerializationWrapperPass();
 ModulePass *createGenXCoalescingWrapperPass();
 ModulePass *createGenXGVClobberCheckerWrapperPass();
+ModulePass *createGenXLivenessBenchWrapperPass();
 ModulePass *createGenXAddressCommoningWrapperPass();
 ModulePass *createGenXArgIndirectionWrapperPass();
 FunctionPass *createGenXTidyControlFlowPass();
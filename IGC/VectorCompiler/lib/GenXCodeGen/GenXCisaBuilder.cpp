@@ -6389,6 +6389,11 @@ collectFinalizerArgs(StringSaver &Saver, const GenXSubtarget &ST,
   if (WATable && WATable->Wa_14012437816)
     addArgument("-LSCFenceWA");
 
+  if (unsigned Threads = BC.getFinalizerThreads(); Threads > 1) {
+    addArgument("-finalizeThreads");
+    addArgument(to_string(Threads));
+  }
+
   if (BC.isHashMovsEnabled()) {
     uint64_t Hash = BC.getAsmHash();
     uint32_t HashLo = Hash;
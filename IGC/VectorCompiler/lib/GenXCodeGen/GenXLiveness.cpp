@@ -33,6 +33,7 @@ SPDX-License-Identifier: MIT
 #include "llvmWrapper/IR/InstrTypes.h"
 #include "llvmWrapper/IR/Instructions.h"
 
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/IR/BasicBlock.h"
@@ -76,14 +77,13 @@ bool GenXLiveness::runOnFunctionGroup(FunctionGroup &ArgFG)
  */
 void GenXLiveness::releaseMemory() {
   LLVM_DEBUG(dbgs() << "releaseMemory for GenXLivness\n");
-  while (!LiveRangeMap.empty()) {
-    LiveRange *LR = begin()->second;
-    for (auto i = LR->value_begin(), e = LR->value_end(); i != e; ++i) {
-      SimpleValue V = *i;
-      LiveRangeMap.erase(V);
-    }
+  // A live range is shared by all its values, so delete each one once.
+  SmallPtrSet<LiveRange *, 64> LRs;
+  for (auto &Entry : LiveRangeMap)
+    LRs.insert(Entry.second);
+  for (LiveRange *LR : LRs)
     delete LR;
-  }
+  LiveRangeMap.clear();
   FG = 0;
   CG.reset();
   for (auto i = UnifiedRets.begin(), e = UnifiedRets.end(); i != e; ++i)
@@ -1024,6 +1024,17 @@ bool GenXLiveness::getSingleInterferenceSites(LiveRange *LR1, LiveRange *LR2,
   auto Idx1 = LR1->find(Idx2->getStart()), End1 = LR1->end();
   if (Idx1 == End1)
     return false;
+  // Segments that end before the start of the current segment of the other
+  // live range cannot overlap it, so skip them with a binary search rather
+  // than one at a time. This keeps the walk O(m log n) when a short live
+  // range is checked against a long one.
+  auto SkipEndingBefore = [](LiveRange::iterator Idx, LiveRange::iterator End,
+                             unsigned Start) {
+    if (Idx == End || Idx->getEnd() >= Start)
+      return Idx;
+    return std::partition_point(
+        Idx, End, [Start](const Segment &S) { return S.getEnd() < Start; });
+  };
   for (;;) {
     // Check for overlap.
     if (Idx1->getStart() < Idx2->getStart()) {
@@ -1047,10 +1058,12 @@ bool GenXLiveness::getSingleInterferenceSites(LiveRange *LR1, LiveRange *LR2,
     }
     // Advance whichever one has the lowest End.
     if (Idx1->getEnd() < Idx2->getEnd()) {
-      if (++Idx1 == End1)
+      Idx1 = SkipEndingBefore(++Idx1, End1, Idx2->getStart());
+      if (Idx1 == End1)
         return false;
     } else {
-      if (++Idx2 == End2)
+      Idx2 = SkipEndingBefore(++Idx2, End2, Idx1->getStart());
+      if (Idx2 == End2)
         return false;
     }
   }
@@ -1458,19 +1471,20 @@ void GenXLiveness::setArgAddressBase(Value *Addr, Value *Base) {
   auto Res = ArgAddressBaseMap.find(Addr);
   if (Res != ArgAddressBaseMap.end()) {
     Value *PreviousBase = Res->second;
-    auto AddrsRange = BaseToArgAddrMap.equal_range(PreviousBase);
-    auto ToRemove = std::find_if(AddrsRange.first, AddrsRange.second,
-                                 [Addr](auto It) { return It.second == Addr; });
+    auto &Addrs = BaseToArgAddrMap[PreviousBase];
+    auto ToRemove = llvm::find(Addrs, Addr);
     IGC_ASSERT_MESSAGE(
-        ToRemove != AddrsRange.second,
+        ToRemove != Addrs.end(),
         "Addr -> PreviousBase exists in ArgAddressBaseMap. It must "
         "exist in BaseToArgAddrMap too.");
-    BaseToArgAddrMap.erase(ToRemove);
+    Addrs.erase(ToRemove);
+    if (Addrs.empty())
+      BaseToArgAddrMap.erase(PreviousBase);
   }
 
   // Set the new connection between address and base.
   ArgAddressBaseMap[Addr] = Base;
-  BaseToArgAddrMap.insert({Base, Addr});
+  BaseToArgAddrMap[Base].push_back(Addr);
 }
 
 /***********************************************************************
@@ -1528,11 +1542,10 @@ Value *GenXLiveness::getAddressBase(Value *Addr)
  *          arguments indirect addresses, empty vector otherwise.
  */
 std::vector<Value *> GenXLiveness::getAddressWithBase(Value *Base) {
-  auto Res = BaseToArgAddrMap.equal_range(Base);
-  std::vector<Value *> Bases;
-  std::transform(Res.first, Res.second, std::back_inserter(Bases),
-                 [](auto It) { return It.second; });
-  return Bases;
+  auto Res = BaseToArgAddrMap.find(Base);
+  if (Res == BaseToArgAddrMap.end())
+    return {};
+  return std::vector<Value *>(Res->second.begin(), Res->second.end());
 }
 
 /***********************************************************************
@@ -1846,10 +1859,11 @@ void LiveRange::printSegments(raw_ostream &OS) const
  */
 void genx::CallGraph::build(GenXLiveness *Liveness) {
   Nodes.clear();
+  NodeIndex.clear();
   // Create a node for each Function.
   for (auto fgi = FG->begin(), fge = FG->end(); fgi != fge; ++fgi) {
     Function *F = *fgi;
-    (void)Nodes[F];
+    (void)getOrCreateNode(F);
   }
   // For each Function, find its call sites and add edges for them.
   for (auto fgi = FG->begin() + 1, fge = FG->end(); fgi != fge; ++fgi) {
@@ -1864,11 +1878,25 @@ void genx::CallGraph::build(GenXLiveness *Liveness) {
         auto IID = vc::getAnyIntrinsicID(Call);
         if (Call->getCalledFunction() && !vc::isAnyNonTrivialIntrinsic(IID) &&
             Caller != F)
-          Nodes[Caller].insert(
+          getOrCreateNode(Caller).insert(
               Edge(Liveness->getNumbering()->getNumber(Call), Call));
       }
     }
   }
+  for (Node &N : Nodes)
+    N.sortEdges();
+}
+
+genx::CallGraph::Node &genx::CallGraph::getOrCreateNode(Function *F) {
+  auto Res = NodeIndex.insert({F, Nodes.size()});
+  if (Res.second)
+    Nodes.emplace_back();
+  return Nodes[Res.first->second];
+}
+
+void genx::CallGraph::Node::sortEdges() {
+  std::stable_sort(Edges.begin(), Edges.end());
+  Edges.erase(std::unique(Edges.begin(), Edges.end()), Edges.end());
 }
 
 INITIALIZE_PASS_BEGIN(GenXLivenessWrapper, "GenXLivenessWrapper",
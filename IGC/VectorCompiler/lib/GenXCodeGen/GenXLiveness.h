@@ -165,8 +165,10 @@ SPDX-License-Identifier: MIT
 #include "Probe/Assertion.h"
 #include "vc/Utils/General/IndexFlattener.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Value.h"
 #include "llvm/IR/ValueHandle.h"
@@ -432,16 +434,24 @@ public:
     Edge() : Number(0), Call(0) {}
     Edge(unsigned Number, CallInst *Call) : Number(Number), Call(Call) {}
   };
+  // Node : the calls made by a Function, in number order
   class Node {
-    std::set<Edge> Edges;
+    SmallVector<Edge, 4> Edges;
   public:
-    typedef std::set<Edge>::iterator iterator;
+    typedef SmallVectorImpl<Edge>::iterator iterator;
     iterator begin() { return Edges.begin(); }
     iterator end() { return Edges.end(); }
-    void insert(Edge E) { Edges.insert(E); }
+    void insert(Edge E) { Edges.push_back(E); }
+    // sortEdges : sort the edges and drop duplicates, once all inserted
+    void sortEdges();
   };
 private:
-  std::map<Function *, Node> Nodes;
+  // Nodes are stored flat and found through an index by Function.
+  std::vector<Node> Nodes;
+  DenseMap<Function *, unsigned> NodeIndex;
+  // Node returned for a Function that has none: it makes no calls.
+  Node EmptyNode;
+  Node &getOrCreateNode(Function *F);
 public:
   // constructor from FunctionGroup
   CallGraph(FunctionGroup *FG) : FG(FG) {}
@@ -449,28 +459,51 @@ public:
   void build(GenXLiveness *Liveness);
 
   // getRoot : get the root node
-  Node *getRoot() { return &Nodes[FG->getHead()]; }
+  Node *getRoot() { return getNode(FG->getHead()); }
   // getNode : get the node for a Function
-  Node *getNode(Function *F) { return &Nodes[F]; }
+  Node *getNode(Function *F) {
+    auto It = NodeIndex.find(F);
+    return It == NodeIndex.end() ? &EmptyNode : &Nodes[It->second];
+  }
 };
 
 } // end namespace genx
 
+// Specialize DenseMapInfo for SimpleValue.
+template <> struct DenseMapInfo<genx::SimpleValue> {
+  static inline genx::SimpleValue getEmptyKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
+  }
+  static inline genx::SimpleValue getTombstoneKey() {
+    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
+  }
+  static unsigned getHashValue(const genx::SimpleValue &SV) {
+    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
+           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
+  }
+  static bool isEqual(const genx::SimpleValue &LHS,
+                      const genx::SimpleValue &RHS) {
+    return LHS == RHS;
+  }
+};
+
 class GenXLiveness : public FGPassImplInterface, public IDMixin<GenXLiveness> {
   FunctionGroup *FG = nullptr;
-  using LiveRangeMap_t = std::map<genx::SimpleValue, genx::LiveRange *>;
+  // Live range of each value, queried all the time by coalescing and
+  // register allocation, so hashed rather than kept in a tree.
+  using LiveRangeMap_t = DenseMap<genx::SimpleValue, genx::LiveRange *>;
   LiveRangeMap_t LiveRangeMap;
   std::unique_ptr<genx::CallGraph> CG;
   GenXBaling *Baling = nullptr;
   GenXNumbering *Numbering = nullptr;
   const GenXSubtarget *Subtarget = nullptr;
   const DataLayout *DL = nullptr;
-  std::map<Function *, Value *> UnifiedRets;
-  std::map<Value *, Function *> UnifiedRetToFunc;
-  std::map<AssertingVH<Value>, Value *> ArgAddressBaseMap;
-  // Flipped ArgAddressBaseMap. Mulpimap is chosen because the same base may be
-  // used for different convert.addr instructions.
-  std::multimap<Value *, Value *> BaseToArgAddrMap;
+  DenseMap<Function *, Value *> UnifiedRets;
+  DenseMap<Value *, Function *> UnifiedRetToFunc;
+  DenseMap<AssertingVH<Value>, Value *> ArgAddressBaseMap;
+  // Flipped ArgAddressBaseMap. The same base may be used for different
+  // convert.addr instructions, which are kept in the order they were set.
+  DenseMap<Value *, SmallVector<Value *, 2>> BaseToArgAddrMap;
 
   bool CoalescingDisabled = false;
 
@@ -490,7 +523,7 @@ public:
   // This gives you an iterator of LiveRangeMap. The ->first field is the
   // value, and you only get each value once. The ->second field is the
   // LiveRange pointer, and you may get each one multiple times because
-  // a live range may contain multiple values.
+  // a live range may contain multiple values. The order is unspecified.
   typedef LiveRangeMap_t::iterator iterator;
   typedef LiveRangeMap_t::const_iterator const_iterator;
   iterator begin() { return LiveRangeMap.begin(); }
@@ -607,24 +640,6 @@ using GenXLivenessWrapper = FunctionGroupWrapperPass<GenXLiveness>;
 
 void initializeGenXLivenessWrapperPass(PassRegistry &);
 
-// Specialize DenseMapInfo for SimpleValue.
-template <> struct DenseMapInfo<genx::SimpleValue> {
-  static inline genx::SimpleValue getEmptyKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getEmptyKey());
-  }
-  static inline genx::SimpleValue getTombstoneKey() {
-    return genx::SimpleValue(DenseMapInfo<Value *>::getTombstoneKey());
-  }
-  static unsigned getHashValue(const genx::SimpleValue &SV) {
-    return DenseMapInfo<Value *>::getHashValue(SV.getValue()) ^
-           DenseMapInfo<unsigned>::getHashValue(SV.getIndex());
-  }
-  static bool isEqual(const genx::SimpleValue &LHS,
-                      const genx::SimpleValue &RHS) {
-    return LHS == RHS;
-  }
-};
-
 } // end namespace llvm
 namespace std {
 template <> struct hash<llvm::genx::Segment> {
@@ -0,0 +1,147 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+//
+/// GenXLivenessBench
+/// -----------------
+///
+/// Measures how fast GenXLiveness answers the queries that coalescing and
+/// register allocation make all the time: the live range of a value, and
+/// whether two live ranges interfere. For each function group it prints the
+/// number of values, live ranges and segments along with the lookup and
+/// interference query rates to stderr. Nothing is modified.
+///
+/// It is run right before coalescing, where the live ranges are the most
+/// numerous, with -vc-liveness-bench in llc, or on its own in opt.
+///
+//===----------------------------------------------------------------------===//
+
+#include "FunctionGroup.h"
+#include "GenX.h"
+#include "GenXLiveness.h"
+
+#include "Probe/Assertion.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <vector>
+
+#define DEBUG_TYPE "GENX_LIVENESS_BENCH"
+
+using namespace llvm;
+using namespace genx;
+
+static cl::opt<unsigned> LivenessBenchRepeat(
+    "vc-liveness-bench-repeat", cl::init(16), cl::Hidden,
+    cl::desc("Number of times each liveness query is repeated"));
+
+static cl::opt<unsigned> LivenessBenchMaxLRs(
+    "vc-liveness-bench-max-lrs", cl::init(1024), cl::Hidden,
+    cl::desc("Number of live ranges checked pairwise for interference"));
+
+namespace {
+
+class GenXLivenessBench : public FGPassImplInterface,
+                          public IDMixin<GenXLivenessBench> {
+public:
+  explicit GenXLivenessBench() {}
+  static StringRef getPassName() { return "GenX liveness benchmark"; }
+  static void getAnalysisUsage(AnalysisUsage &AU) {
+    AU.addRequired<GenXLiveness>();
+    AU.setPreservesAll();
+  }
+  bool runOnFunctionGroup(FunctionGroup &FG) override;
+};
+
+} // namespace
+
+namespace llvm {
+void initializeGenXLivenessBenchWrapperPass(PassRegistry &);
+using GenXLivenessBenchWrapper = FunctionGroupWrapperPass<GenXLivenessBench>;
+} // namespace llvm
+INITIALIZE_PASS_BEGIN(GenXLivenessBenchWrapper, "GenXLivenessBenchWrapper",
+                      "GenX liveness benchmark", false, true)
+INITIALIZE_PASS_DEPENDENCY(GenXLivenessWrapper)
+INITIALIZE_PASS_END(GenXLivenessBenchWrapper, "GenXLivenessBenchWrapper",
+                    "GenX liveness benchmark", false, true)
+
+ModulePass *llvm::createGenXLivenessBenchWrapperPass() {
+  initializeGenXLivenessBenchWrapperPass(*PassRegistry::getPassRegistry());
+  return new GenXLivenessBenchWrapper();
+}
+
+// Operations per second, or 0 if it was too fast to be measured.
+static double getRate(uint64_t Count, double Secs) {
+  return Secs > 0 ? Count / Secs : 0;
+}
+
+bool GenXLivenessBench::runOnFunctionGroup(FunctionGroup &FG) {
+  auto &Liveness = getAnalysis<GenXLiveness>();
+
+  // The values queried are the ones with a live range, in the order the map
+  // gives them, which is as random as the order coalescing asks for them.
+  std::vector<SimpleValue> Values;
+  std::vector<LiveRange *> LRs;
+  SmallPtrSet<LiveRange *, 64> SeenLRs;
+  unsigned NumSegments = 0;
+  for (auto &Entry : Liveness) {
+    Values.push_back(Entry.first);
+    if (!SeenLRs.insert(Entry.second).second)
+      continue;
+    LRs.push_back(Entry.second);
+    NumSegments += Entry.second->size();
+  }
+  // Live ranges without a segment are never checked for interference.
+  std::vector<LiveRange *> QueriedLRs;
+  for (LiveRange *LR : LRs)
+    if (LR->size() && QueriedLRs.size() < LivenessBenchMaxLRs)
+      QueriedLRs.push_back(LR);
+
+  using Clock = std::chrono::steady_clock;
+  auto secondsSince = [](Clock::time_point Start) {
+    return std::chrono::duration<double>(Clock::now() - Start).count();
+  };
+
+  // Keep the results alive so the queries are not optimized away.
+  uint64_t Found = 0;
+  uint64_t Lookups = 0;
+  auto Start = Clock::now();
+  for (unsigned R = 0; R != LivenessBenchRepeat; ++R)
+    for (SimpleValue V : Values) {
+      Found += Liveness.getLiveRangeOrNull(V) != nullptr;
+      ++Lookups;
+    }
+  double LookupSecs = secondsSince(Start);
+
+  uint64_t Interfering = 0;
+  uint64_t Queries = 0;
+  Start = Clock::now();
+  for (unsigned R = 0; R != LivenessBenchRepeat; ++R)
+    for (size_t I = 0, E = QueriedLRs.size(); I != E; ++I)
+      for (size_t J = I + 1; J != E; ++J) {
+        Interfering += Liveness.interfere(QueriedLRs[I], QueriedLRs[J]);
+        ++Queries;
+      }
+  double QuerySecs = secondsSince(Start);
+
+  errs() << "GenXLivenessBench: " << FG.getName() << "\n"
+         << "  values: " << Values.size() << ", live ranges: " << LRs.size()
+         << ", segments: " << NumSegments << "\n"
+         << "  lookups: " << Lookups << " ("
+         << format("%.0f", getRate(Lookups, LookupSecs)) << "/s)\n"
+         << "  interference queries: " << Queries << " ("
+         << format("%.0f", getRate(Queries, QuerySecs)) << "/s), "
+         << Interfering / std::max(1u, unsigned(LivenessBenchRepeat))
+         << " interfering\n";
+  IGC_ASSERT(Found == Lookups);
+  return false;
+}
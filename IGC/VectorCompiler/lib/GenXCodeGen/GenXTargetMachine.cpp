@@ -70,6 +70,10 @@ static cl::opt<std::string>
     FGDumpsPrefix("vc-fg-dump-prefix", cl::init(""), cl::Hidden,
                   cl::desc("prefix to use for FG dumps"));
 
+static cl::opt<bool>
+    LivenessBench("vc-liveness-bench", cl::init(false), cl::Hidden,
+                  cl::desc("Benchmark liveness queries before coalescing"));
+
 static cl::opt<bool> EmitVLoadStore(
     "genx-emit-vldst", cl::init(true), cl::Hidden,
     cl::desc("Emit load/store intrinsic calls for pass-by-ref arguments"));
@@ -111,6 +115,7 @@ void initializeGenXPasses(PassRegistry &registry) {
   initializeGenXLiveRangesWrapperPass(registry);
   // initializeGenXLivenessWrapperPass(registry);
   initializeGenXLivenessWrapperPass(registry);
+  initializeGenXLivenessBenchWrapperPass(registry);
   initializeGenXLowerAggrCopiesPass(registry);
   initializeGenXLoweringPass(registry);
   initializeGenXModulePass(registry);
@@ -610,6 +615,8 @@ bool GenXTargetMachine::addPassesToEmitFile(PassManagerBase &PM,
   /// .. include:: GenXGVClobberChecker.cpp
   if (BackendConfig.checkGVClobbering())
     vc::addPass(PM, createGenXGVClobberCheckerWrapperPass());
+  if (LivenessBench)
+    vc::addPass(PM, createGenXLivenessBenchWrapperPass());
   /// .. include:: GenXCoalescing.cpp
   vc::addPass(PM, createGenXCoalescingWrapperPass());
   /// .. include:: GenXAddressCommoning.cpp
@@ -233,6 +233,7 @@ void initializeGenXLateSimdCFConformanceWrapperPass(PassRegistry &);
 void initializeGenXLegacyToLscTranslatorPass(PassRegistry &);
 void initializeGenXLegalizationPass(PassRegistry &);
 void initializeGenXLiveRangesWrapperPass(PassRegistry &);
+void initializeGenXLivenessBenchWrapperPass(PassRegistry &);
 void initializeGenXLivenessWrapperPass(PassRegistry &);
 void initializeGenXLoadStoreLegalizationPass(PassRegistry &);
 void initializeGenXLoadStoreLoweringPass(PassRegistry &);
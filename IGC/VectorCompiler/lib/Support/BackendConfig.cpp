@@ -148,6 +148,11 @@ static cl::opt<bool> VCIgnoreLoopUnrollThresholdOnPragma(
     cl::desc("Ignore threshold value for LLVM loop unroll pass when pragma is "
              "used"));
 
+static cl::opt<unsigned> FinalizerThreadsOpt(
+    "vc-finalizer-threads", cl::Hidden,
+    cl::desc("Number of threads to compile the function groups on in the "
+             "finalizer"));
+
 static cl::opt<unsigned> InteropSubgroupSizeOpt("vc-interop-subgroup-size", cl::Hidden,
     cl::desc("Set subgroup size used for cross-module calls"));
 
@@ -204,6 +209,7 @@ void GenXBackendOptions::enforceLLVMOptions() {
   enforceOptionIfSpecified(IgnoreLoopUnrollThresholdOnPragma,
                            VCIgnoreLoopUnrollThresholdOnPragma);
   enforceOptionIfSpecified(InteropSubgroupSize, InteropSubgroupSizeOpt);
+  enforceOptionIfSpecified(FinalizerThreads, FinalizerThreadsOpt);
   enforceOptionIfSpecified(CheckGVClobbering, CheckGVClobberingOpt);
 }
 
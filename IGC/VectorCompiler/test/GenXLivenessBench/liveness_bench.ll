@@ -0,0 +1,44 @@
+;=========================== begin_copyright_notice ============================
+;
+; Copyright (C) 2023 Intel Corporation
+;
+; SPDX-License-Identifier: MIT
+;
+;============================ end_copyright_notice =============================
+
+; RUN: opt %use_old_pass_manager% -GenXModule -GenXNumberingWrapper -GenXLiveRangesWrapper \
+; RUN:  -GenXLivenessBenchWrapper -vc-liveness-bench-repeat=2 \
+; RUN:  -march=genx64 -mcpu=Gen9 -mtriple=spir64-unknown-unknown -disable-output < %s 2>&1 | FileCheck %s
+
+; CHECK: GenXLivenessBench: kernel_A
+; CHECK-NEXT: values: {{[1-9][0-9]*}}, live ranges: {{[1-9][0-9]*}}, segments: {{[1-9][0-9]*}}
+; CHECK-NEXT: lookups: {{[1-9][0-9]*}} ({{[0-9]+}}/s)
+; CHECK-NEXT: interference queries: {{[0-9]+}} ({{[0-9]+}}/s), {{[0-9]+}} interfering
+
+target datalayout = "e-p:64:64-i64:64-n8:16:32:64"
+target triple = "spir64-unknown-unknown"
+
+declare void @llvm.genx.raw.sends2.noresult.v16i1.v16i32.v16i32(i8, i8, <16 x i1>, i8, i8, i8, i32, i32, <16 x i32>, <16 x i32>)
+
+define dllexport spir_kernel void @kernel_A(<16 x i32> %a, <16 x i32> %b) local_unnamed_addr #0 {
+  %add = add <16 x i32> %a, %b
+  %mul = mul <16 x i32> %add, %a
+  tail call void @llvm.genx.raw.sends2.noresult.v16i1.v16i32.v16i32(i8 0, i8 0, <16 x i1> <i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true>, i8 1, i8 1, i8 15, i32 0, i32 34472967, <16 x i32> %add, <16 x i32> %mul)
+  ret void
+}
+
+attributes #0 = { "CMGenxMain" }
+
+!genx.kernels = !{!0}
+!genx.kernel.internal = !{!5}
+
+!0 = !{void (<16 x i32>, <16 x i32>)* @kernel_A, !"kernel_A", !1, i32 0, !2, !3, !4, i32 0}
+!1 = !{i32 0, i32 0}
+!2 = !{i32 64, i32 128}
+!3 = !{i32 0, i32 0}
+!4 = !{!"", !""}
+!5 = !{void (<16 x i32>, <16 x i32>)* @kernel_A, !6, !7, !8, !9}
+!6 = !{i32 0, i32 0}
+!7 = !{i32 0, i32 1}
+!8 = !{}
+!9 = !{i32 -1, i32 -1}
@@ -0,0 +1,33 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef IGCLLVM_SUPPORT_THREADPOOL_H
+#define IGCLLVM_SUPPORT_THREADPOOL_H
+
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+
+#include <memory>
+
+namespace IGCLLVM {
+// Creates a thread pool with NumThreads workers; 0 means one worker per
+// hardware thread.
+inline std::unique_ptr<llvm::ThreadPool> createThreadPool(unsigned NumThreads) {
+#if LLVM_VERSION_MAJOR < 11
+  if (NumThreads == 0)
+    NumThreads = llvm::hardware_concurrency();
+  return std::make_unique<llvm::ThreadPool>(NumThreads);
+#else
+  return std::make_unique<llvm::ThreadPool>(
+      llvm::hardware_concurrency(NumThreads));
+#endif
+}
+} // namespace IGCLLVM
+
+#endif // IGCLLVM_SUPPORT_THREADPOOL_H
@@ -22,19 +22,61 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 #endif
 
+#include <cstring>
 #include <iostream>
 #include <tuple>
 #include "Probe/Assertion.h"
 
 namespace zebin {
 
+/// ELFBufferStream - A raw_pwrite_stream writing into a preallocated buffer of
+///                   fixed size. Without a buffer it only counts the bytes
+///                   written, which is how ZEELFObjectBuilder computes the
+///                   object size before allocating the buffer.
+class ELFBufferStream : public llvm::raw_pwrite_stream {
+public:
+    ELFBufferStream(char* buf, uint64_t size) : m_buf(buf), m_size(size)
+    {
+        SetUnbuffered();
+    }
+
+    ~ELFBufferStream() override { flush(); }
+
+private:
+    void write_impl(const char* ptr, size_t size) override
+    {
+        if (m_buf) {
+            IGC_ASSERT(m_pos + size <= m_size);
+            memcpy(m_buf + m_pos, ptr, size);
+        }
+        m_pos += size;
+    }
+
+    void pwrite_impl(const char* ptr, size_t size, uint64_t offset) override
+    {
+        if (m_buf) {
+            IGC_ASSERT(offset + size <= m_size);
+            memcpy(m_buf + offset, ptr, size);
+        }
+    }
+
+    uint64_t current_pos() const override { return m_pos; }
+
+    char* m_buf;
+    uint64_t m_size;
+    uint64_t m_pos = 0;
+};
+
 /// ELFWriter - A helper class to write ELF contents into given raw_pwrite_stream,
 ///             according to the given ZEELFObjectBuilder. This object should
 ///             only be used by ZEELFObjectBuilder
 class ELFWriter {
 public:
+    // zeInfoYAML - the already serialized ze_info contents, if any; otherwise
+    //              ze_info is serialized while writing
     ELFWriter(llvm::raw_pwrite_stream& OS,
-        ZEELFObjectBuilder& objBuilder);
+        ZEELFObjectBuilder& objBuilder,
+        const std::string* zeInfoYAML = nullptr);
 
     // write the ELF file into OS, return the number of written bytes
     uint64_t write();
@@ -132,6 +174,7 @@ private:
     llvm::support::endian::Writer m_W;
     llvm::StringTableBuilder m_StrTabBuilder{llvm::StringTableBuilder::ELF};
     ZEELFObjectBuilder& m_ObjBuilder;
+    const std::string* m_ZEInfoYAML;
 
     // Map Section::m_id to ELF section index, used for creating symbol table
     SectionIndexMapTy m_SectionIndex;
@@ -375,6 +418,34 @@ uint64_t ZEELFObjectBuilder::finalize(llvm::raw_pwrite_stream& os)
     return w.write();
 }
 
+uint64_t ZEELFObjectBuilder::finalize(const std::function<char*(uint64_t)>& allocate)
+{
+    // serialize ze_info once, both passes below write the same text
+    std::string zeInfoYAML;
+    if (m_zeInfoSection) {
+        llvm::raw_string_ostream os(zeInfoYAML);
+        llvm::yaml::Output yout(os);
+        yout << m_zeInfoSection->getZeInfo();
+    }
+    const std::string* zeInfo = m_zeInfoSection ? &zeInfoYAML : nullptr;
+
+    // layout pass: count the bytes without writing anything
+    uint64_t size = 0;
+    {
+        ELFBufferStream counter(nullptr, 0);
+        ELFWriter w(counter, *this, zeInfo);
+        size = w.write();
+    }
+
+    char* buf = allocate(size);
+    IGC_ASSERT(buf != nullptr || size == 0);
+    ELFBufferStream os(buf, size);
+    ELFWriter w(os, *this, zeInfo);
+    uint64_t written = w.write();
+    IGC_ASSERT(written == size);
+    return written;
+}
+
 ZEELFObjectBuilder::SectionID
 ZEELFObjectBuilder::getSectionIDBySectionName(const char* name)
 {
@@ -570,10 +641,14 @@ uint64_t ELFWriter::writeSymTab()
 uint64_t ELFWriter::writeZEInfo()
 {
     uint64_t start_off = m_W.OS.tell();
-    // serialize ze_info contents
-    llvm::yaml::Output yout(m_W.OS);
     IGC_ASSERT(m_ObjBuilder.m_zeInfoSection);
-    yout << m_ObjBuilder.m_zeInfoSection->getZeInfo();
+    if (m_ZEInfoYAML) {
+        m_W.OS << *m_ZEInfoYAML;
+    } else {
+        // serialize ze_info contents
+        llvm::yaml::Output yout(m_W.OS);
+        yout << m_ObjBuilder.m_zeInfoSection->getZeInfo();
+    }
 
     return m_W.OS.tell() - start_off;
 }
@@ -907,8 +982,10 @@ uint16_t ELFWriter::numOfSections()
 }
 
 ELFWriter::ELFWriter(llvm::raw_pwrite_stream& OS,
-                     ZEELFObjectBuilder& objBuilder)
-    : m_W(OS, llvm::support::little), m_ObjBuilder(objBuilder)
+                     ZEELFObjectBuilder& objBuilder,
+                     const std::string* zeInfoYAML)
+    : m_W(OS, llvm::support::little), m_ObjBuilder(objBuilder),
+      m_ZEInfoYAML(zeInfoYAML)
 {
 }
 
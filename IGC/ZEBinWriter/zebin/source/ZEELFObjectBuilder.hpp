@@ -31,6 +31,7 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 #endif
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -219,6 +220,15 @@ public:
     // return number of written bytes
     uint64_t finalize(llvm::raw_pwrite_stream& os);
 
+    // finalize - Finalize the ELF Object straight into a single buffer.
+    // The layout of the object is computed first, without touching the
+    // section contents, then allocate(size) is called to get a buffer of
+    // exactly that size and the object is written into it. Section contents
+    // are copied once, from the buffers given to the add* functions into the
+    // returned buffer.
+    // return number of written bytes
+    uint64_t finalize(const std::function<char*(uint64_t)>& allocate);
+
     // get an ID of a section
     // - name  : section name
     SectionID getSectionIDBySectionName(const char* name);
@@ -487,7 +487,7 @@ const SkipCommand* findApplicableSkipCommand(const PassDisableConfig& pdc, const
 
 void displaySkippedPass(const PassDisableConfig& pdc, const std::string& currentPassName, const SkipCommand* skippedByCommand)
 {
-    static bool displayHeader = true;
+    thread_local bool displayHeader = true;
     std::string skippedByString = "Invalid skip pass case";
     TokenSkipCase skippedBy = WrongFormat;
     if (skippedByCommand)
@@ -556,9 +556,11 @@ Build succeeded.
 */
 void displayAllPasses(const Pass* P)
 {
-    static unsigned int countPass = 0;
+    // Numbered per thread, that is per compilation when several compilations
+    // run at the same time.
+    thread_local unsigned int countPass = 0;
     const std::string currentPassName = P->getPassName().str();
-    static std::unordered_map<std::string, int> passesOccuranceCountToDisplay;
+    thread_local std::unordered_map<std::string, int> passesOccuranceCountToDisplay;
 
     auto result = passesOccuranceCountToDisplay.try_emplace(currentPassName, 1);
     if (!result.second) {
@@ -587,14 +589,8 @@ void IGCPassManager::add(Pass *P)
         return;
 
     //check only once
-    static bool checkedToggles = false;
-    static bool hasToggles = false;
     static std::bitset<1024> toggles;
-    if (!checkedToggles)
-    {
-        checkedToggles = true;
-        hasToggles = getPassToggles(toggles);
-    }
+    static const bool hasToggles = getPassToggles(toggles);
     if (hasToggles && m_pContext->m_numPasses < 1024 && toggles[m_pContext->m_numPasses])
     {
         errs() << "Skipping pass: '" << P->getPassName() << "\n";
@@ -612,8 +608,9 @@ void IGCPassManager::add(Pass *P)
 
     if (IGC_IS_FLAG_ENABLED(ShaderPassDisable))
     {
-        // Parse Flag Input once in PassDisableConfig constructor
-        static PassDisableConfig pdc;
+        // Parse Flag Input once in PassDisableConfig constructor. Passes are
+        // counted per thread, that is per compilation.
+        thread_local PassDisableConfig pdc;
         const std::string currentPassName = P->getPassName().str();
 
         // Fill the passesOccuranceCount
@@ -649,14 +646,16 @@ void IGCPassManager::add(Pass *P)
         addPrintPass(P, true);
     }
 
-    if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
+    if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS) ||
+        IGC_IS_FLAG_ENABLED(DumpTraceEvents))
     {
         PassManager::add(createTimeStatsIGCPass(m_pContext, m_name + '_' + pname, STATS_COUNTER_START));
     }
 
     PassManager::add(P);
 
-    if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS))
+    if (IGC_REGKEY_OR_FLAG_ENABLED(DumpTimeStatsPerPass, TIME_STATS_PER_PASS) ||
+        IGC_IS_FLAG_ENABLED(DumpTraceEvents))
     {
         PassManager::add(createTimeStatsIGCPass(m_pContext, m_name + '_' + pname, STATS_COUNTER_END));
     }
@@ -20,6 +20,7 @@ SPDX-License-Identifier: MIT
 #include "StringMacros.hpp"
 #include "common/igc_regkeys.hpp"
 
+#include <atomic>
 #include <iostream>
 
 using namespace llvm;
@@ -197,11 +198,10 @@ MDNode* CreateNode(const std::vector<val> &vec, Module* module, StringRef name)
                 + "ShaderOverride flag may not work properly without " + flagName + " enabled.";
 
             //Print warning once in console, print every time in LLVM ShaderDump
-            static bool printWarningFirstTime = true;
-            if (printWarningFirstTime)
+            static std::atomic<bool> printWarningFirstTime(true);
+            if (printWarningFirstTime.exchange(false))
             {
                 fprintf(stderr, "\n%s\n\n", warningMessage.c_str());
-                printWarningFirstTime = false;
             }
             nodes.push_back(CreateNode(false, module, warningMessage + " " + flagName + " currently equals"));
             break;
@@ -7,6 +7,7 @@ SPDX-License-Identifier: MIT
 ============================= end_copyright_notice ===========================*/
 
 #include "common/Stats.hpp"
+#include "common/TraceEvents.hpp"
 #include "Compiler/CodeGenPublic.h"
 #include "common/debug/Dump.hpp"
 
@@ -434,6 +435,10 @@ void TimeStats::recordTimerStart( COMPILE_TIME_INTERVALS compileInterval )
     IGC_ASSERT(0 <= compileInterval);
     IGC_ASSERT(compileInterval < MAX_COMPILE_TIME_INTERVALS);
     m_wallclockStart[ compileInterval ] = iSTD::GetTimestampCounter();
+    if (IGC::TraceEvents::isEnabled())
+    {
+        IGC::TraceEvents::begin(g_cCompTimeIntervals[compileInterval], "IGC");
+    }
 }
 
 void TimeStats::recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval )
@@ -442,6 +447,10 @@ void TimeStats::recordTimerEnd( COMPILE_TIME_INTERVALS compileInterval )
     IGC_ASSERT(compileInterval < MAX_COMPILE_TIME_INTERVALS);
     m_elapsedTime[ compileInterval ] += iSTD::GetTimestampCounter() - m_wallclockStart[ compileInterval ];
     m_hitCount[ compileInterval ]++;
+    if (IGC::TraceEvents::isEnabled())
+    {
+        IGC::TraceEvents::end(g_cCompTimeIntervals[compileInterval], "IGC");
+    }
 }
 
 uint64_t TimeStats::getCompileTime( COMPILE_TIME_INTERVALS compileInterval ) const
@@ -724,6 +733,11 @@ void TimeStats::recordPerPassTimerStart(std::string PassName)
     {
         iter->second.PassClockStart = iSTD::GetTimestampCounter();
     }
+
+    if (IGC::TraceEvents::isEnabled())
+    {
+        IGC::TraceEvents::begin(PassName, "pass");
+    }
 }
 
 void TimeStats::recordPerPassTimerEnd(std::string PassName)
@@ -744,6 +758,11 @@ void TimeStats::recordPerPassTimerEnd(std::string PassName)
         iter->second.PassHitCount += 1;
         iter->second.PassElapsedTime += elapsed;
         m_PassTotalTicks += elapsed;
+
+        if (IGC::TraceEvents::isEnabled())
+        {
+            IGC::TraceEvents::end(PassName, "pass");
+        }
     }
 }
 
@@ -1211,6 +1230,11 @@ void MemUsageSnapshot( IGC::SHADER_MEMORY_SNAPSHOT phase )
             g_MemoryReport.UsageReset();
         }
         g_MemoryReport.UsageSnapshot( phase );
+        if (IGC::TraceEvents::isEnabled())
+        {
+            IGC::TraceEvents::counter("Heap used", "bytes", g_MemoryReport.m_Stat.HeapUsed);
+            IGC::TraceEvents::counter("Heap used peak", "bytes", g_MemoryReport.m_Stat.HeapUsedPeak);
+        }
     }
 }
 
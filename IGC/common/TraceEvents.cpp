@@ -0,0 +1,174 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "common/TraceEvents.hpp"
+#include "common/Stats.hpp"
+#include "common/igc_regkeys.hpp"
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/raw_ostream.h>
+#include "common/LLVMWarningsPop.hpp"
+
+#include <chrono>
+#include <mutex>
+
+// Functions exposed by VISA lib API
+extern "C" void setTimerEventCallback(void (*callback)(unsigned int idx, uint64_t startUS, uint64_t endUS));
+
+using namespace llvm;
+
+namespace IGC
+{
+namespace TraceEvents
+{
+namespace
+{
+    // Buffered events are written out once they grow past this size.
+    constexpr size_t FlushThreshold = 1 << 20;
+
+    // Written after the last event, so that the file is a complete JSON
+    // array after every flush. The next flush writes over it.
+    constexpr StringRef Terminator = "\n]\n";
+
+    class TraceLog
+    {
+    public:
+        void add(StringRef Name, StringRef Category, char Phase, uint64_t TimeUS,
+            uint64_t DurationUS = 0, StringRef Series = StringRef(), int64_t Value = 0)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            raw_string_ostream OS(m_Buffer);
+            // Every event is preceded by a separator; the one of the first
+            // event of the file is dropped when it is written.
+            OS << ",\n{\"name\":" << json::Value(json::fixUTF8(Name))
+               << ",\"cat\":" << json::Value(json::fixUTF8(Category))
+               << ",\"ph\":\"" << Phase << "\",\"ts\":" << TimeUS;
+            if (Phase == 'X')
+                OS << ",\"dur\":" << DurationUS;
+            OS << ",\"pid\":" << sys::Process::getProcessId()
+               << ",\"tid\":" << get_threadid();
+            if (Phase == 'C')
+                OS << ",\"args\":{" << json::Value(json::fixUTF8(Series)) << ':' << Value << '}';
+            OS << '}';
+            OS.flush();
+            if (m_Buffer.size() > FlushThreshold)
+                flushLocked();
+        }
+
+        void flush()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            flushLocked();
+        }
+
+    private:
+        void flushLocked()
+        {
+            if (m_Buffer.empty())
+                return;
+
+            SmallString<256> Path(IGC::Debug::GetShaderOutputFolder());
+            sys::path::append(Path, "igc_trace_" + std::to_string(sys::Process::getProcessId()) + ".json");
+            std::error_code EC;
+            // The file is created by the first flush of the process. Later
+            // flushes write their events over the terminator of the array
+            // and terminate it again.
+            raw_fd_ostream OS(Path, EC,
+                m_Created ? sys::fs::CD_OpenExisting : sys::fs::CD_CreateAlways,
+                sys::fs::FA_Write, sys::fs::OF_None);
+            if (EC)
+                return;
+            if (m_Created)
+            {
+                OS.seek(m_Size - Terminator.size());
+                OS << m_Buffer;
+            }
+            else
+            {
+                OS << "[\n" << StringRef(m_Buffer).drop_front(2);
+            }
+            OS << Terminator;
+            m_Size = OS.tell();
+            m_Created = true;
+            m_Buffer.clear();
+        }
+
+        std::mutex m_Mutex;
+        std::string m_Buffer;
+        bool m_Created = false;
+        uint64_t m_Size = 0;
+    };
+
+    TraceLog& getLog()
+    {
+        static TraceLog Log;
+        return Log;
+    }
+
+    void onVISATimer(unsigned int Idx, uint64_t StartUS, uint64_t EndUS)
+    {
+        // vISA timers map to the TIME_VISA_* intervals in TimerDefs.h order.
+        unsigned Interval = TIME_VISA_TOTAL + Idx;
+        if (Interval < TIME_VISA_Unaccounted)
+            complete(g_cCompTimeIntervals[Interval], "vISA", StartUS, EndUS);
+    }
+} // namespace
+
+bool isEnabled()
+{
+    return IGC_IS_FLAG_ENABLED(DumpTraceEvents);
+}
+
+uint64_t now()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void begin(StringRef Name, StringRef Category)
+{
+    getLog().add(Name, Category, 'B', now());
+}
+
+void end(StringRef Name, StringRef Category)
+{
+    getLog().add(Name, Category, 'E', now());
+}
+
+void complete(StringRef Name, StringRef Category, uint64_t StartUS, uint64_t EndUS)
+{
+    getLog().add(Name, Category, 'X', StartUS, EndUS - StartUS);
+}
+
+void counter(StringRef Name, StringRef Series, int64_t Value)
+{
+    getLog().add(Name, "memory", 'C', now(), 0, Series, Value);
+}
+
+void attachVISATimers()
+{
+    static std::once_flag Attached;
+    if (isEnabled())
+    {
+        std::call_once(Attached, [] { setTimerEventCallback(onVISATimer); });
+    }
+}
+
+void flush()
+{
+    getLog().flush();
+}
+
+} // namespace TraceEvents
+} // namespace IGC
@@ -0,0 +1,89 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#pragma once
+
+#include "common/LLVMWarningsPush.hpp"
+#include <llvm/ADT/StringRef.h>
+#include "common/LLVMWarningsPop.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace IGC
+{
+    /// Compile-time trace in the Chrome trace-event JSON format, for
+    /// chrome://tracing, Perfetto or scripts aggregating compile times.
+    ///
+    /// When DumpTraceEvents is set, the TimeStats intervals, the per-pass
+    /// timers, the vISA timers, per-kernel spans and the memory snapshots
+    /// all end up as events in igc_trace_<pid>.json in the shader dump
+    /// folder. Events of every compilation of the process go to the same
+    /// file, tagged with the thread that produced them. Events are buffered
+    /// and written at the end of each translation (and when the buffer gets
+    /// large); the file is a complete JSON array after every write.
+    ///
+    /// vISA phases are only reported by builds that measure them, i.e. with
+    /// MEASURE_COMPILATION_TIME (debug, internal and standalone builds);
+    /// release driver builds leave the vISA timers, and so these events,
+    /// compiled out.
+    namespace TraceEvents
+    {
+        bool isEnabled();
+
+        /// Microseconds on the clock all the events are stamped with.
+        uint64_t now();
+
+        /// Open and close a span on the current thread. Spans opened on a
+        /// thread have to be closed in reverse order on that same thread.
+        void begin(llvm::StringRef Name, llvm::StringRef Category);
+        void end(llvm::StringRef Name, llvm::StringRef Category);
+
+        /// A span of the current thread whose bounds are already known.
+        void complete(llvm::StringRef Name, llvm::StringRef Category, uint64_t StartUS, uint64_t EndUS);
+
+        /// A sample of a counter track.
+        void counter(llvm::StringRef Name, llvm::StringRef Series, int64_t Value);
+
+        /// Forward the vISA timers to the trace. Done once, the first time
+        /// it is called with the trace enabled. Has no visible effect
+        /// unless vISA is built with MEASURE_COMPILATION_TIME.
+        void attachVISATimers();
+
+        /// Write the buffered events to the trace file and terminate the
+        /// JSON array.
+        void flush();
+
+        class Scope
+        {
+        public:
+            Scope(std::string Name, llvm::StringRef Category)
+                : m_Enabled(isEnabled()), m_Category(Category)
+            {
+                if (m_Enabled)
+                {
+                    m_Name = std::move(Name);
+                    begin(m_Name, m_Category);
+                }
+            }
+            ~Scope()
+            {
+                if (m_Enabled)
+                    end(m_Name, m_Category);
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            bool m_Enabled;
+            std::string m_Name;
+            llvm::StringRef m_Category;
+        };
+    } // namespace TraceEvents
+} // namespace IGC
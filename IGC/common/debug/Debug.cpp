@@ -277,12 +277,8 @@ namespace {
 
 void RegisterErrHandlers()
 {
-    static bool executed = false;
-    if (!executed)
-    {
-        install_fatal_error_handler( FatalErrorHandler, nullptr );
-        executed = true;
-    }
+    static std::once_flag installed;
+    std::call_once(installed, []() { install_fatal_error_handler( FatalErrorHandler, nullptr ); });
 }
 
 void RegisterComputeErrHandlers(LLVMContext &C)
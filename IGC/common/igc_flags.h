@@ -136,6 +136,7 @@ DECLARE_IGC_REGKEY(bool, DisablePayloadCoalescing_RT,   false, "Setting this to
 DECLARE_IGC_REGKEY(bool, DisablePayloadCoalescing_Sample, false, "Setting this to 1/true adds a compiler switch to disable payload coalescing optimization for Samplers only", false)
 DECLARE_IGC_REGKEY(bool, DisablePayloadCoalescing_URB,  false, "Setting this to 1/true adds a compiler switch to disable payload coalescing optimization for URB writes only", false)
 DECLARE_IGC_REGKEY(bool, DisableUniformAnalysis,        false, "Setting this to 1/true adds a compiler switch to disable uniform_analysis", false)
+DECLARE_IGC_REGKEY(bool, EnableWIAnalysisCache,         true,  "Reuse the WIAnalysis results of a function that has not changed since it was last analyzed instead of recomputing them", false)
 DECLARE_IGC_REGKEY(bool, EnableWorkGroupUniformGoto,    false, "Setting to 1 enables generating uniform goto for work group uniform [eu fusion only]", false)
 DECLARE_IGC_REGKEY(DWORD, DisablePushConstant,           0, "Bit mask to disable push constant per shader stages. bit0 = All, Bit 1 = VS, Bit 2 = HS, Bit 3 = DS, Bit 4 = GS, Bit 5 = PS", false)
 DECLARE_IGC_REGKEY(DWORD, DisableAttributePush,          0, "Bit mask to disable push Attribute per shader stages. bit0 = All, Bit 1 = VS, Bit 2 = HS, Bit 3 = DS, Bit 4 = GS", false)
@@ -305,6 +306,7 @@ DECLARE_IGC_REGKEY(bool, EnableTrivialEmulateSinCos,    false, "Enable Emulation
 DECLARE_IGC_REGKEY(DWORD, ld2dmsInstsClubbingThreshold, 3,     "Do not club more than these ld2dms insts into the new BB during MCSOpt", false)
 DECLARE_IGC_REGKEY(DWORD, ForcePerThreadPrivateMemorySize, 0,  "Useful for ensuring a certain amount of private memory when doing a shader override.", true)
 DECLARE_IGC_REGKEY(DWORD, RetryManagerFirstStateId,     0,     "For debugging purposes, it can be useful to start on a particular id rather than id 0.", false)
+DECLARE_IGC_REGKEY(bool, RetryFromUnifiedModule,       true,  "Keep a copy of the OCL module after unification and recompile retried kernels from it instead of parsing the input again", false)
 DECLARE_IGC_REGKEY(bool, DisableSendSrcDstOverlapWA,    false, "Disable Send Source/destination overlap WA which is enabled for GEN10/GEN11 and whenever Wddm2Svm is set in WATable", false)
 DECLARE_IGC_REGKEY(debugString, DisablePassToggles,     0,     "Disable each IGC pass by setting the bit. HEXADECIMAL ONLY!. Ex: C0 is to disable pass 6 and pass 7.", false)
 DECLARE_IGC_REGKEY(bool, ShaderDisplayAllPassesNames,   false, "Display to console all passes name with their ID and occurrence number.", false)
@@ -363,10 +365,12 @@ DECLARE_IGC_REGKEY(bool, DumpVariableAlias,             false, "Dump variable al
 DECLARE_IGC_REGKEY(bool, DumpResourceLoop,              false, "dump resource loop detected by ResourceLoopAnalysis", true)
 DECLARE_IGC_REGKEY(bool, DumpDeSSA,                     false, "dump DeSSA info into file.", true)
 DECLARE_IGC_REGKEY(bool, DumpWIA,                       false, "dump WI (uniform) infomation into files in dump directory if set to true", false)
+DECLARE_IGC_REGKEY(bool, DumpWIAnalysisCacheStats,      false, "dump the number of WIAnalysis runs that reused cached results, per function, into a file in dump directory at the end of each compilation", false)
 DECLARE_IGC_REGKEY(bool, EnableScalarizerDebugLog,      false, "print step by step scalarizer debug info.", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStats,                 false, "Timing of translation, code generation, finalizer, etc", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsCoarse,           false, "Only collect/dump coarse level time stats, i.e. skip opt detail timer for now", true)
 DECLARE_IGC_REGKEY(bool, DumpTimeStatsPerPass,          false, "Collect Timing of IGC/LLVM passes", true)
+DECLARE_IGC_REGKEY(bool, DumpTraceEvents,               false, "Write timing of IGC/LLVM passes, vISA phases (builds with MEASURE_COMPILATION_TIME only) and kernels, and memory snapshots as Chrome trace-event JSON to igc_trace_<pid>.json in the dump folder, at the end of every translation", true)
 DECLARE_IGC_REGKEY(bool, DumpHasNonKernelArgLdSt,       false, "Print if hasNonKernelArg load/store to stderr", true)
 DECLARE_IGC_REGKEY(bool, PrintPsoDdiHash,               true,  "Print psoDDIHash in TimeStats_Shaders.csv file", true)
 DECLARE_IGC_REGKEY(bool, ShaderDataBaseStats,           false, "Enable gathering sends' sizes for shader statistics", false)
@@ -390,6 +394,10 @@ DECLARE_IGC_REGKEY(bool, DebugInfoValidation,           false, "Enable optional
 DECLARE_IGC_REGKEY(bool, deadLoopForFloatException,           false, "enable a dead loop if float exception happened", false)
 DECLARE_IGC_REGKEY(debugString, ExtraOCLOptions,        0,     "Extra options for OpenCL", true)
 DECLARE_IGC_REGKEY(debugString, ExtraOCLInternalOptions, 0,    "Extra internal options for OpenCL", true)
+DECLARE_IGC_REGKEY(debugString, OCLCompilationCacheDir, 0,     "Directory of a persistent cache of OpenCL translation outputs, shared between processes. Empty disables the cache", true)
+DECLARE_IGC_REGKEY(DWORD, OCLCompilationCacheMaxSizeMB, 1024,  "Size in MB above which the least recently used entries of OCLCompilationCacheDir are evicted. 0 - unbounded", true)
+DECLARE_IGC_REGKEY(bool, PrintOCLCompilationCache,     false, "Print the hits and misses of the OCLCompilationCacheDir cache to stderr", true)
+DECLARE_IGC_REGKEY(DWORD, TieredCompilationMaxResults,   64,    "Number of tier-1 builds of tiered OpenCL translations kept at once, pending or not taken yet. 0 - no tier-1 builds", true)
 DECLARE_IGC_REGKEY(bool, UseVISAVarNames,               false, "Make VISA generate names for virtual variables so they match with dbg file", true)
 DECLARE_IGC_REGKEY(DWORD, MetricsDumpEnable,            0,     "Dump IGC Metrics to file *.optrpt in current working directory.\
                                                                 Setting to 0 - disabled, 1 - makes in binary format, 2 - makes in plain-text format.", true)
@@ -404,8 +412,12 @@ DECLARE_IGC_REGKEY(bool, StackOverflowDetection,        false, "Inserts checks f
 DECLARE_IGC_GROUP("IGC Features")
 DECLARE_IGC_REGKEY(bool, EnableOCLSIMD16,               true,  "Enable OCL SIMD16 mode", true)
 DECLARE_IGC_REGKEY(bool, EnableOCLSIMD32,               true,  "Enable OCL SIMD32 mode", true)
+DECLARE_IGC_REGKEY(bool, SelectOCLSIMDByCycleEstimate,  false, "Compile every allowed and profitable OCL SIMD width and keep the spill-free one with the lowest vISA estimate of cycles per work-item", true)
 DECLARE_IGC_REGKEY(DWORD, ForceOCLSIMDWidth,            0,     "Force using SIMD width specified. 0 : no forcing. This overrides driver forced SIMD value(if any) and runtime behaviour could be different if driver expects something fixed", true)
 DECLARE_IGC_REGKEY(bool, SendMultipleSIMDModesCS,       true,  "Send multiple SIMD modes for CS", false)
+DECLARE_IGC_REGKEY(bool, EnableParallelSIMDCompile,     false, "Finalize the vISA of the SIMD variants of a kernel concurrently when multiple SIMD modes are compiled [OCL only]", true)
+DECLARE_IGC_REGKEY(bool, EnableParallelKernelCompile,   false, "Finalize the vISA of different kernels of a program concurrently, output order is kept [OCL only]", true)
+DECLARE_IGC_REGKEY(DWORD, ParallelCompileThreads,       0,     "Number of worker threads used for parallel vISA finalization. 0 : one per hardware thread", true)
 DECLARE_IGC_REGKEY(DWORD, OCLSIMD16SelectionMask,       6,     "Select SIMD 16 heuristics. Valid values are 0, 1, 2 and 3", false)
 DECLARE_IGC_REGKEY(bool, EnableHSSinglePatchDispatch,   false, "Setting this to 1/true enables SIMD8 single-patch dispatch in HullShader. Default is either SIMD8 single patch/dual patch dispatch based on control point count", false)
 DECLARE_IGC_REGKEY(bool, DisableGPGPUIndirectPayload,   false, "Disable OCL indirect GPGPU payload", false)
@@ -871,5 +883,6 @@ DECLARE_IGC_GROUP("VectorCompiler Options")
     DECLARE_IGC_REGKEY(bool, VCSaveStackCallLinkage, false,
                        "Do not override stack calls linkage as internal", true)
     DECLARE_IGC_REGKEY(bool, VCDirectCallsOnly, false, "Generate code under the assumption all unknown calls are direct", true)
+    DECLARE_IGC_REGKEY(DWORD, VCFinalizeThreads, 0, "Number of threads the vISA finalizer compiles the kernels and functions of a VC module on. 0 or 1 compiles them one after another", true)
     DECLARE_IGC_REGKEY(DWORD, VCLoopUnrollThreshold, 0, "Set the loop unroll threshold for VC. Value 0 will use the default threshold.", true)
     DECLARE_IGC_REGKEY(bool, VCIgnoreLoopUnrollThresholdOnPragma, false, "Ignore threshold for loop unrolling when pragma is used", true)
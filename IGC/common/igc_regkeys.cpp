@@ -45,6 +45,100 @@ SPDX-License-Identifier: MIT
 #define IGC_REGISTRY_KEY "SOFTWARE\\INTEL\\IGFX\\IGC"
 
 SRegKeysList g_RegKeyList;
+thread_local RegKeysOverlay* g_pThreadRegKeys = nullptr;
+std::atomic<unsigned> g_NumActiveRegKeysOverlays{0};
+static thread_local ShaderHash g_CurrentShaderHash;
+
+RegKeysOverlay::RegKeysOverlay(const RegKeysOverlay* pBase)
+{
+    const SRegKeyVariableMetaData* pRegKeyVariable = (const SRegKeyVariableMetaData*)&g_RegKeyList;
+    for (unsigned i = 0; i < NUM_REGKEY_ENTRIES; i++)
+    {
+        const SRegKeyVariableMetaData* pKey = pBase ? pBase->find(pRegKeyVariable[i]) : nullptr;
+        if (!pKey)
+        {
+            pKey = &pRegKeyVariable[i];
+            // Keys left to their default are read from g_RegKeyList.
+            if (!pKey->IsSet() && !pKey->m_isSetToNonDefaultValue && pKey->hashes.empty())
+                pKey = nullptr;
+        }
+        if (pKey)
+            activate();
+        m_Keys[i].store(pKey ? pKey->Clone() : nullptr, std::memory_order_relaxed);
+    }
+}
+
+RegKeysOverlay::~RegKeysOverlay()
+{
+    for (auto& key : m_Keys)
+    {
+        delete key.load(std::memory_order_relaxed);
+    }
+    if (m_Active)
+        g_NumActiveRegKeysOverlays.fetch_sub(1, std::memory_order_release);
+}
+
+// Counted before its first key is stored, for the lookups that see the key
+// to also see the count.
+void RegKeysOverlay::activate()
+{
+    if (!m_Active)
+    {
+        m_Active = true;
+        g_NumActiveRegKeysOverlays.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+SRegKeyVariableMetaData& RegKeysOverlay::getForWrite(const SRegKeyVariableMetaData& key)
+{
+    std::atomic<SRegKeyVariableMetaData*>& entry = m_Keys[getIndex(key)];
+    SRegKeyVariableMetaData* pKey = entry.load(std::memory_order_acquire);
+    if (!pKey)
+    {
+        std::lock_guard<std::mutex> lock(m_WriteMutex);
+        pKey = entry.load(std::memory_order_acquire);
+        if (!pKey)
+        {
+            activate();
+            pKey = key.Clone();
+            entry.store(pKey, std::memory_order_release);
+        }
+    }
+    return *pKey;
+}
+
+RegKeysContext GetThreadRegKeysContext()
+{
+    RegKeysContext context;
+    context.pKeys = g_pThreadRegKeys;
+    context.hash = g_CurrentShaderHash;
+    return context;
+}
+
+RegKeysScope::RegKeysScope(const RegKeysContext& context)
+    : m_Prev(GetThreadRegKeysContext())
+{
+    g_pThreadRegKeys = context.pKeys;
+    g_CurrentShaderHash = context.hash;
+}
+
+RegKeysScope::~RegKeysScope()
+{
+    g_pThreadRegKeys = m_Prev.pKeys;
+    g_CurrentShaderHash = m_Prev.hash;
+}
+
+RegKeysSnapshot::RegKeysSnapshot()
+    : m_pKeys(new RegKeysOverlay(g_pThreadRegKeys)), m_pPrev(g_pThreadRegKeys)
+{
+    g_pThreadRegKeys = m_pKeys;
+}
+
+RegKeysSnapshot::~RegKeysSnapshot()
+{
+    g_pThreadRegKeys = m_pPrev;
+    delete m_pKeys;
+}
 
 #if defined(_WIN64) || defined(_WIN32)
 
@@ -756,7 +850,7 @@ static void ParseHashRange(llvm::StringRef line, std::vector<HashRange>& ranges)
 }
 
 static void setIGCKeyOnHash(
-    std::vector<HashRange>& hashes, const unsigned value,
+    const std::vector<HashRange>& hashes, const unsigned value,
     SRegKeyVariableMetaData* var)
 {
     // hashes can be empty if the var is not set via Options.txt
@@ -848,7 +942,7 @@ static void setImpliedIGCKeys()
     IGC_SET_IMPLIED_REGKEY(ForceOCLSIMDWidth,  8, EnableOCLSIMD16, false);
 }
 
-void setImpliedRegkey(SRegKeyVariableMetaData& name,
+void setImpliedRegkey(const SRegKeyVariableMetaData& name,
     const bool set,
     SRegKeyVariableMetaData& subname,
     const unsigned subvalue)
@@ -951,16 +1045,15 @@ void appendToOptionsLogFile(std::string const &message)
     os.close();
 }
 
-static thread_local ShaderHash g_CurrentShaderHash;
 void SetCurrentDebugHash(const ShaderHash& hash)
 {
     g_CurrentShaderHash = hash;
 }
 
-bool CheckHashRange(SRegKeyVariableMetaData& varname)
+// The hash range of varname the current shader is in, nullptr if there is
+// none. Only reads varname, which other threads may be reading as well.
+static const HashRange* FindHashRange(const SRegKeyVariableMetaData& varname)
 {
-    if (varname.hashes.empty())
-        return true;
     if (!g_CurrentShaderHash.is_set())
     {
         std::string msg = "Warning: hash not calculated yet; IGC_GET_FLAG_VALUE(" + std::string(varname.GetName()) + ") returned default value";
@@ -972,7 +1065,6 @@ bool CheckHashRange(SRegKeyVariableMetaData& varname)
         unsigned long long CurrHash = it.getHashVal(g_CurrentShaderHash);
         if (CurrHash >= it.start && CurrHash <= it.end)
         {
-            varname.m_Value = it.m_Value;
             constexpr uint32_t Len = 100;
             char msg[Len];
             int size = snprintf(msg, Len, "Shader %#0llx: %s=%d", CurrHash, varname.GetName(), it.m_Value);
@@ -981,10 +1073,31 @@ bool CheckHashRange(SRegKeyVariableMetaData& varname)
                 appendToOptionsLogFile(msg);
             }
 
-            return true;
+            return &it;
         }
     }
-    return false;
+    return nullptr;
+}
+
+bool CheckHashRange(const SRegKeyVariableMetaData& varname)
+{
+    return varname.hashes.empty() || FindHashRange(varname);
+}
+
+unsigned GetRegKeyValue(const SRegKeyVariableMetaData& varname)
+{
+    if (varname.hashes.empty())
+        return varname.m_Value;
+    const HashRange* range = FindHashRange(varname);
+    return range ? range->m_Value : varname.GetDefault();
+}
+
+const char* GetRegKeyString(const SRegKeyVariableMetaData& varname)
+{
+    if (varname.hashes.empty())
+        return varname.m_string;
+    const HashRange* range = FindHashRange(varname);
+    return range ? range->m_string : "";
 }
 
 static void LoadFromRegKeyOrEnvVarOrOptions(
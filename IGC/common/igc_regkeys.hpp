@@ -32,6 +32,8 @@ typedef char debugString[1024];
 
 
 #if defined(IGC_DEBUG_VARIABLES)
+#include <atomic>
+#include <mutex>
 #include <vector>
 struct HashRange
 {
@@ -84,6 +86,7 @@ struct SRegKeyVariableMetaData
     virtual const char* GetName() const = 0;
     virtual unsigned GetDefault() const = 0;
     virtual void SetToNonDefaultValue() = 0;
+    virtual SRegKeyVariableMetaData* Clone() const = 0;
     virtual ~SRegKeyVariableMetaData()
     {
     }
@@ -125,6 +128,10 @@ struct SRegKeyVariableMetaData_##regkeyName : public SRegKeyVariableMetaData \
     {                                               \
         return releaseMode;                         \
     }                                               \
+    SRegKeyVariableMetaData* Clone() const          \
+    {                                               \
+        return new SRegKeyVariableMetaData_##regkeyName(*this); \
+    }                                               \
 } regkeyName;                                       \
 static_assert(sizeof(regkeyName) == sizeof(SRegKeyVariableMetaData));
 
@@ -136,47 +143,155 @@ struct SRegKeysList
 #include "igc_regkeys.h"
 };
 #undef DECLARE_IGC_REGKEY
-bool CheckHashRange(SRegKeyVariableMetaData& varname);
-void setImpliedRegkey(SRegKeyVariableMetaData& name,
+bool CheckHashRange(const SRegKeyVariableMetaData& varname);
+unsigned GetRegKeyValue(const SRegKeyVariableMetaData& varname);
+const char* GetRegKeyString(const SRegKeyVariableMetaData& varname);
+void setImpliedRegkey(const SRegKeyVariableMetaData& name,
     const bool set,
     SRegKeyVariableMetaData& subname,
     const unsigned value);
 
 extern SRegKeysList g_RegKeyList;
+
+constexpr unsigned NUM_REGKEY_ENTRIES = sizeof(SRegKeysList) / sizeof(SRegKeyVariableMetaData);
+
+/// Keys of one compilation that differ from g_RegKeyList: the keys that are
+/// set when it starts and the keys the compilation sets itself, copied on the
+/// first write. The other keys are read from g_RegKeyList, which doesn't
+/// change once LoadRegistryKeys() is done.
+class RegKeysOverlay
+{
+public:
+    /// Starts from the keys of pBase, or from g_RegKeyList if it is nullptr.
+    explicit RegKeysOverlay(const RegKeysOverlay* pBase);
+    ~RegKeysOverlay();
+
+    RegKeysOverlay(const RegKeysOverlay&) = delete;
+    RegKeysOverlay& operator=(const RegKeysOverlay&) = delete;
+
+    /// The copy of key, a member of g_RegKeyList, nullptr if there is none.
+    const SRegKeyVariableMetaData* find(const SRegKeyVariableMetaData& key) const
+    {
+        return m_Keys[getIndex(key)].load(std::memory_order_acquire);
+    }
+
+    SRegKeyVariableMetaData& getForWrite(const SRegKeyVariableMetaData& key);
+
+private:
+    static unsigned getIndex(const SRegKeyVariableMetaData& key)
+    {
+        size_t offset = reinterpret_cast<const char*>(&key) - reinterpret_cast<const char*>(&g_RegKeyList);
+        IGC_ASSERT(offset < sizeof(SRegKeysList));
+        return static_cast<unsigned>(offset / sizeof(SRegKeyVariableMetaData));
+    }
+
+    void activate();
+
+    // Written by the compilation while the threads working for it read.
+    std::atomic<SRegKeyVariableMetaData*> m_Keys[NUM_REGKEY_ENTRIES];
+    std::mutex m_WriteMutex;
+    // Holds a key, counted in g_NumActiveRegKeysOverlays.
+    bool m_Active = false;
+};
+
+// Keys of the compilation running on the current thread, nullptr if it
+// runs on g_RegKeyList alone.
+extern thread_local RegKeysOverlay* g_pThreadRegKeys;
+
+// Number of overlays holding at least one key. While there is none, which is
+// the case unless keys are set, lookups read g_RegKeyList without looking
+// up the overlay of the thread.
+extern std::atomic<unsigned> g_NumActiveRegKeysOverlays;
+
+template <typename T>
+inline const T& GetRegKey(const T& key)
+{
+    if (g_NumActiveRegKeysOverlays.load(std::memory_order_acquire) == 0)
+        return key;
+    const SRegKeyVariableMetaData* pKey = g_pThreadRegKeys ? g_pThreadRegKeys->find(key) : nullptr;
+    return pKey ? static_cast<const T&>(*pKey) : key;
+}
+
+template <typename T>
+inline T& GetRegKeyForWrite(T& key)
+{
+    return g_pThreadRegKeys ? static_cast<T&>(g_pThreadRegKeys->getForWrite(key)) : key;
+}
+
+/// What a flag lookup depends on besides g_RegKeyList: the keys of the
+/// compilation and the hash of the shader it compiles.
+struct RegKeysContext
+{
+    RegKeysOverlay* pKeys = nullptr;
+    ShaderHash hash;
+};
+
+RegKeysContext GetThreadRegKeysContext();
+
+/// Runs the current thread in the given context for the lifetime of the
+/// scope, e.g. a helper thread doing work for a compilation.
+class RegKeysScope
+{
+public:
+    explicit RegKeysScope(const RegKeysContext& context);
+    ~RegKeysScope();
+
+    RegKeysScope(const RegKeysScope&) = delete;
+    RegKeysScope& operator=(const RegKeysScope&) = delete;
+
+private:
+    RegKeysContext m_Prev;
+};
+
+/// Keys private to one compilation, used by the current thread for the
+/// lifetime of the snapshot. The keys a compilation sets don't leak into
+/// the compilations that run next to it or after it.
+class RegKeysSnapshot
+{
+public:
+    RegKeysSnapshot();
+    ~RegKeysSnapshot();
+
+    RegKeysSnapshot(const RegKeysSnapshot&) = delete;
+    RegKeysSnapshot& operator=(const RegKeysSnapshot&) = delete;
+
+private:
+    RegKeysOverlay* m_pKeys;
+    RegKeysOverlay* m_pPrev;
+};
+
 #if defined(LINUX_RELEASE_MODE)
 #define IGC_GET_FLAG_VALUE(name)                 \
-  ((CheckHashRange(g_RegKeyList.name) && g_RegKeyList.name.IsReleaseMode()) ? g_RegKeyList.name.m_Value : g_RegKeyList.name.GetDefault())
+  (g_RegKeyList.name.IsReleaseMode() ? GetRegKeyValue(GetRegKey(g_RegKeyList.name)) : g_RegKeyList.name.GetDefault())
 #define IGC_IS_FLAG_SET(name)                    \
-  (CheckHashRange(g_RegKeyList.name) ? g_RegKeyList.name.IsSet() : false)
+  (CheckHashRange(GetRegKey(g_RegKeyList.name)) ? GetRegKey(g_RegKeyList.name).IsSet() : false)
 #define IGC_GET_FLAG_DEFAULT_VALUE(name)         (g_RegKeyList.name.GetDefault())
 #define IGC_IS_FLAG_ENABLED(name)                (IGC_GET_FLAG_VALUE(name) != 0)
 #define IGC_IS_FLAG_DISABLED(name)               (!IGC_IS_FLAG_ENABLED(name))
-#define IGC_SET_FLAG_VALUE(name, regkeyValue)    (g_RegKeyList.name.m_Value = regkeyValue)
+#define IGC_SET_FLAG_VALUE(name, regkeyValue)    (GetRegKeyForWrite(g_RegKeyList.name).m_Value = regkeyValue)
 #define IGC_GET_REGKEYSTRING(name)               \
-  ((CheckHashRange(g_RegKeyList.name) && g_RegKeyList.name.IsReleaseMode()) ? g_RegKeyList.name.m_string : "")
+  (g_RegKeyList.name.IsReleaseMode() ? GetRegKeyString(GetRegKey(g_RegKeyList.name)) : "")
 #define IGC_SET_IMPLIED_REGKEY(name, setOnValue, subname, subvalue) \
-  (setImpliedRegkey(g_RegKeyList.name, (g_RegKeyList.name.m_Value == setOnValue), \
-                    g_RegKeyList.subname, subvalue))
+  (setImpliedRegkey(GetRegKey(g_RegKeyList.name), (GetRegKey(g_RegKeyList.name).m_Value == setOnValue), \
+                    GetRegKeyForWrite(g_RegKeyList.subname), subvalue))
 #define IGC_SET_IMPLIED_REGKEY_ANY(name, subname, subvalue) \
-  (setImpliedRegkey(g_RegKeyList.name, (g_RegKeyList.name.m_Value != 0), \
-                    g_RegKeyList.subname, subvalue))
+  (setImpliedRegkey(GetRegKey(g_RegKeyList.name), (GetRegKey(g_RegKeyList.name).m_Value != 0), \
+                    GetRegKeyForWrite(g_RegKeyList.subname), subvalue))
 #else
-#define IGC_GET_FLAG_VALUE(name)                 \
-  (CheckHashRange(g_RegKeyList.name) ? g_RegKeyList.name.m_Value : g_RegKeyList.name.GetDefault())
+#define IGC_GET_FLAG_VALUE(name)                 (GetRegKeyValue(GetRegKey(g_RegKeyList.name)))
 #define IGC_IS_FLAG_SET(name)                    \
-  (CheckHashRange(g_RegKeyList.name) ? g_RegKeyList.name.IsSet() : false)
+  (CheckHashRange(GetRegKey(g_RegKeyList.name)) ? GetRegKey(g_RegKeyList.name).IsSet() : false)
 #define IGC_GET_FLAG_DEFAULT_VALUE(name)         (g_RegKeyList.name.GetDefault())
 #define IGC_IS_FLAG_ENABLED(name)                (IGC_GET_FLAG_VALUE(name) != 0)
 #define IGC_IS_FLAG_DISABLED(name)               (!IGC_IS_FLAG_ENABLED(name))
-#define IGC_SET_FLAG_VALUE(name, regkeyValue)    (g_RegKeyList.name.m_Value = regkeyValue)
-#define IGC_GET_REGKEYSTRING(name)               \
-  (CheckHashRange(g_RegKeyList.name) ? g_RegKeyList.name.m_string : "")
+#define IGC_SET_FLAG_VALUE(name, regkeyValue)    (GetRegKeyForWrite(g_RegKeyList.name).m_Value = regkeyValue)
+#define IGC_GET_REGKEYSTRING(name)               (GetRegKeyString(GetRegKey(g_RegKeyList.name)))
 #define IGC_SET_IMPLIED_REGKEY(name, setOnValue, subname, subvalue) \
-  (setImpliedRegkey(g_RegKeyList.name, (g_RegKeyList.name.m_Value == setOnValue), \
-                    g_RegKeyList.subname, subvalue))
+  (setImpliedRegkey(GetRegKey(g_RegKeyList.name), (GetRegKey(g_RegKeyList.name).m_Value == setOnValue), \
+                    GetRegKeyForWrite(g_RegKeyList.subname), subvalue))
 #define IGC_SET_IMPLIED_REGKEY_ANY(name, subname, subvalue) \
-  (setImpliedRegkey(g_RegKeyList.name, (g_RegKeyList.name.m_Value != 0), \
-                    g_RegKeyList.subname, subvalue))
+  (setImpliedRegkey(GetRegKey(g_RegKeyList.name), (GetRegKey(g_RegKeyList.name).m_Value != 0), \
+                    GetRegKeyForWrite(g_RegKeyList.subname), subvalue))
 #endif
 
 #define IGC_REGKEY_OR_FLAG_ENABLED(name, flag) (IGC_IS_FLAG_ENABLED(name) || IGC::Debug::GetDebugFlag(IGC::Debug::DebugFlag::flag))
@@ -219,6 +334,24 @@ static inline void LoadRegistryKeys(const std::string& options = "", bool *RegFl
     IGC_UNUSED(options);
     IGC_UNUSED(RegFlagNameError);
 }
+struct RegKeysContext
+{
+};
+static inline RegKeysContext GetThreadRegKeysContext()
+{
+    return RegKeysContext();
+}
+class RegKeysScope
+{
+public:
+    explicit RegKeysScope(const RegKeysContext& context)
+    {
+        IGC_UNUSED(context);
+    }
+};
+class RegKeysSnapshot
+{
+};
 #define IGC_SET_FLAG_VALUE(name, regkeyValue) true
 #define DECLARE_IGC_REGKEY(dataType, regkeyName, defaultValue, description, releaseMode) \
     static const unsigned int regkeyName##default = (unsigned int)defaultValue;
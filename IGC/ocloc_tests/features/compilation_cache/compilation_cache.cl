@@ -0,0 +1,54 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds the same program several times with a persistent
+// compilation cache. The first build misses and stores its output, the same
+// build then hits. Builds with different options or regkeys miss and get
+// entries of their own.
+
+// REQUIRES: regkeys
+
+// RUN: rm -rf %t.cache
+// RUN: ocloc compile -file %s -options " -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: ocloc compile -file %s -options " -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=HIT
+// RUN: ocloc compile -file %s -options "-cl-opt-disable -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: ocloc compile -file %s -options " -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1,DisableLoopUnroll=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=MISS
+// RUN: ocloc compile -file %s -options "-cl-opt-disable -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=HIT
+
+// A cache entry per distinct build.
+// RUN: ls %t.cache | FileCheck %s --check-prefix=ENTRIES
+
+// Clearing the cache makes the next build miss again.
+// RUN: rm -rf %t.cache
+// RUN: ocloc compile -file %s -options " -igc_opts 'OCLCompilationCacheDir=%t.cache,PrintOCLCompilationCache=1'" -device dg2 2>&1 | FileCheck %s --check-prefix=MISS
+
+// MISS: OCL compilation cache miss: {{[0-9a-f]+}}.igccache
+// MISS: Build succeeded.
+
+// HIT: OCL compilation cache hit: {{[0-9a-f]+}}.igccache
+// HIT: Build succeeded.
+
+// ENTRIES-COUNT-3: {{[0-9a-f]+}}.igccache
+// ENTRIES-NOT: .igccache
+
+__kernel void scale(__global float *data, float factor, int n)
+{
+    for (int i = get_global_id(0); i < n; i += get_global_size(0))
+    {
+        data[i] *= factor;
+    }
+}
+
+__kernel void prefix(__global const int *in, __global int *out, int n)
+{
+    int sum = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        sum += in[i];
+        out[i] = sum;
+    }
+}
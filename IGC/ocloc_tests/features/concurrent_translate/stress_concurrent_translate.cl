@@ -0,0 +1,43 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test compiles the same program on several threads at once, in one
+// process, and checks that every concurrent translation produces the same
+// binary as the serial one.
+
+// RUN: ocloc_concurrent 4 compile -file %s -device dg2 2>&1 | FileCheck %s
+// RUN: ocloc_concurrent 4 compile -file %s -options "-cl-opt-disable" -device dg2 2>&1 | FileCheck %s
+
+// CHECK-NOT: differs from the serial translation
+// CHECK: Build succeeded.
+// CHECK-NOT: differs from the serial translation
+
+__kernel void reduce(__global const float *in, __global float *out, __local float *scratch, int n)
+{
+    int lid = get_local_id(0);
+    float sum = 0.0f;
+    for (int i = get_global_id(0); i < n; i += get_global_size(0))
+        sum += in[i];
+    scratch[lid] = sum;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (int s = get_local_size(0) / 2; s > 0; s /= 2)
+    {
+        if (lid < s)
+            scratch[lid] += scratch[lid + s];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    if (lid == 0)
+        out[get_group_id(0)] = scratch[0];
+}
+
+int square(int x) { return x * x; }
+
+__kernel void squares(__global int *res)
+{
+    int gid = get_global_id(0);
+    res[gid] = square(res[gid]) + square(gid);
+}
@@ -0,0 +1,50 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a kernel that keeps about 160 GRFs live, so it spills with
+// the default 128 GRFs. The pre-RA scheduler, which would pick the GRF mode
+// from its pressure estimate, is disabled, so the kernel starts global RA
+// with 128 GRFs.
+//
+// With -raLargerGRFOnSpill, the first failed coloring moves the kernel up
+// once, to 256 GRFs on dg2, and it then compiles without spilling. Without
+// it, the kernel spills. More than 128 GRFs in use shows the kernel was
+// compiled in the larger mode.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -nopresched -regSharingHeuristics'" -device dg2 2>&1 | FileCheck %s --check-prefixes=CHECK,SPILL
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -nopresched -regSharingHeuristics -raLargerGRFOnSpill'" -device dg2 2>&1 | FileCheck %s --check-prefixes=CHECK,LARGER
+
+// SPILL: //.spill size
+
+// LARGER-NOT: //.spill size
+// LARGER: //.GRF count {{(129|1[3-9][0-9]|2[0-9][0-9])}}{{$}}
+// LARGER-NOT: //.spill size
+
+// CHECK: Build succeeded.
+
+#define N 80
+
+__attribute__((intel_reqd_sub_group_size(16)))
+__kernel void pressure(__global const float *in, __global float *out, int iters)
+{
+    int gid = get_global_id(0);
+    float acc[N];
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        acc[i] = in[gid * N + i];
+    for (int it = 0; it < iters; ++it)
+    {
+        #pragma unroll
+        for (int i = 0; i < N; ++i)
+            acc[i] = mad(acc[i], acc[(i + 1) % N], acc[(i + 7) % N]);
+    }
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        out[gid * N + i] = acc[i];
+}
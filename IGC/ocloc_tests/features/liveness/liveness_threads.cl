@@ -0,0 +1,48 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a kernel with subroutine calls, serially and with vISA
+// inter-procedural liveness analyzing subroutines on 4 threads. blend and
+// spread are called from the kernel and both call mix, so blend and spread are
+// analyzed concurrently. The liveness, and so the final asm, has to be the
+// same as the serial one. The options, which differ, are filtered out.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole'" -device dg2 2>&1 | grep -v options > %t.serial
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -livenessThreads 4'" -device dg2 2>&1 | grep -v options > %t.threads
+// RUN: FileCheck %s --input-file=%t.threads
+// RUN: diff %t.serial %t.threads
+
+// CHECK: call
+// CHECK: Build succeeded.
+
+__attribute__((noinline)) float4 mix(float4 a, float4 b, float t)
+{
+    return mad(b - a, (float4)t, a);
+}
+
+__attribute__((noinline)) float4 blend(float4 a, float4 b, float t)
+{
+    float4 m = mix(a, b, t);
+    return mix(m, a * b, 1.0f - t);
+}
+
+__attribute__((noinline)) float4 spread(float4 a, float t)
+{
+    float4 m = mix(a, a.wzyx, t);
+    return mix(m, a.yxwz, t * t);
+}
+
+__kernel void liveness_threads(__global float4 *data, __global const float *ts)
+{
+    int gid = get_global_id(0);
+    float4 a = data[gid];
+    float4 b = data[gid + get_global_size(0)];
+    float t = ts[gid];
+    data[gid] = blend(a, b, t) + spread(b, t);
+}
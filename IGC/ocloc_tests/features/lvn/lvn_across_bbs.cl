@@ -0,0 +1,54 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test checks the immediates vISA LVN materializes in a kernel with a
+// diamond. Each mad needs K1 = 1234.5f (0x449a5000) and the two arms also
+// need K2 = 777.25f (0x44425000), which are moved into registers first.
+//
+// With LVN per BB, every BB moves its own copies: K1 three times and K2
+// twice. With LVN across extended BBs, the arms reuse the K1 of the entry
+// BB. K2 is still moved in both arms: the value numbered in the then-arm has
+// to be undone on leaving it, as it does not dominate the else-arm.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -printHexFloatInAsm'" -device dg2 2>&1 | FileCheck %s --check-prefixes=CHECK,EBB
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -printHexFloatInAsm -nolvnAcrossBBs'" -device dg2 2>&1 | FileCheck %s --check-prefixes=CHECK,BB
+
+// EBB-COUNT-1: mov {{.*}}0x449{{[aA]}}5000:f
+// EBB-NOT: mov {{.*}}0x449{{[aA]}}5000:f
+
+// BB-COUNT-3: mov {{.*}}0x449{{[aA]}}5000:f
+// BB-NOT: mov {{.*}}0x449{{[aA]}}5000:f
+
+// CHECK: Build succeeded.
+
+// The K2 count is checked separately, as its movs interleave with K1's.
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -printHexFloatInAsm'" -device dg2 2>&1 | FileCheck %s --check-prefix=K2
+// RUN: ocloc compile -file %s -options " -igc_opts 'VISAOptions=-asmToConsole -printHexFloatInAsm -nolvnAcrossBBs'" -device dg2 2>&1 | FileCheck %s --check-prefix=K2
+
+// K2-COUNT-2: mov {{.*}}0x44425000:f
+// K2-NOT: mov {{.*}}0x44425000:f
+// K2: Build succeeded.
+
+__attribute__((intel_reqd_sub_group_size(16)))
+__kernel void diamond(__global float *out, __global int *iout, int n)
+{
+    int gid = get_global_id(0);
+    float x = out[gid];
+    float y = fma(x, x, 1234.5f);
+    if (n > 0)
+    {
+        // Stored as a float ...
+        out[gid] = fma(y, 777.25f, 1234.5f);
+    }
+    else
+    {
+        // ... and as an int, so the arms can not be merged.
+        iout[gid] = (int)fma(y + 1.0f, 777.25f, 1234.5f);
+    }
+}
@@ -0,0 +1,44 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a program where one kernel has enough live values to spill
+// on the first try and another kernel that does not. The spilling kernel is
+// recompiled by the retry, once from the saved unified module and once from
+// the parsed input, and both builds have to succeed.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'RetryFromUnifiedModule=1'" -device dg2 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -options " -igc_opts 'RetryFromUnifiedModule=0'" -device dg2 2>&1 | FileCheck %s
+
+// CHECK: Build succeeded.
+
+#define N 64
+
+__kernel void pressure(__global const float16 *in, __global float16 *out, int iters)
+{
+    int gid = get_global_id(0);
+    float16 acc[N];
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        acc[i] = in[gid * N + i];
+    for (int it = 0; it < iters; ++it)
+    {
+        #pragma unroll
+        for (int i = 0; i < N; ++i)
+            acc[i] = mad(acc[i], acc[(i + 1) % N], acc[(i + 7) % N]);
+    }
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        out[gid * N + i] = acc[i];
+}
+
+__kernel void simple(__global int *res)
+{
+    int gid = get_global_id(0);
+    res[gid] = res[gid] * 2 + gid;
+}
@@ -0,0 +1,56 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a program where the kernel that spills on the first try
+// also makes an indirect call and a call to a function that is not inlined.
+// The retry has to compile it with the same call model as the first try,
+// whether it restarts from the saved unified module or from the parsed input.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'RetryFromUnifiedModule=1'" -device dg2 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -options " -igc_opts 'RetryFromUnifiedModule=0'" -device dg2 2>&1 | FileCheck %s
+
+// CHECK: Build succeeded.
+
+#pragma OPENCL EXTENSION __cl_clang_function_pointers : enable
+
+#define N 64
+
+float16 scale(float16 v) { return v * 0.5f; }
+float16 shift(float16 v) { return v + 1.0f; }
+
+__attribute__((noinline)) float16 combine(float16 a, float16 b)
+{
+    return mad(a, b, a);
+}
+
+__kernel void pressure(__global const float16 *in, __global float16 *out, int iters, int op)
+{
+    float16 (*fn)(float16) = op ? scale : shift;
+    int gid = get_global_id(0);
+    float16 acc[N];
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        acc[i] = in[gid * N + i];
+    for (int it = 0; it < iters; ++it)
+    {
+        #pragma unroll
+        for (int i = 0; i < N; ++i)
+            acc[i] = mad(acc[i], acc[(i + 1) % N], acc[(i + 7) % N]);
+    }
+    acc[0] = combine(fn(acc[0]), acc[N - 1]);
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        out[gid * N + i] = acc[i];
+}
+
+__kernel void simple(__global int *res)
+{
+    int gid = get_global_id(0);
+    res[gid] = res[gid] * 2 + gid;
+}
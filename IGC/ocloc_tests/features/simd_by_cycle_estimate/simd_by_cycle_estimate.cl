@@ -0,0 +1,46 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a program whose SIMD width is picked from the vISA cycle
+// estimates. One kernel has enough live values to spill in the wider
+// variants, which are then not considered; the other has a loop, which the
+// estimate weights by the assumed trip count.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -options " -igc_opts 'SelectOCLSIMDByCycleEstimate=1'" -device dg2 2>&1 | FileCheck %s
+
+// CHECK: Build succeeded.
+
+#define N 64
+
+__kernel void pressure(__global const float16 *in, __global float16 *out, int iters)
+{
+    int gid = get_global_id(0);
+    float16 acc[N];
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        acc[i] = in[gid * N + i];
+    for (int it = 0; it < iters; ++it)
+    {
+        #pragma unroll
+        for (int i = 0; i < N; ++i)
+            acc[i] = mad(acc[i], acc[(i + 1) % N], acc[(i + 7) % N]);
+    }
+    #pragma unroll
+    for (int i = 0; i < N; ++i)
+        out[gid * N + i] = acc[i];
+}
+
+__kernel void loop(__global const float *in, __global float *out, int n)
+{
+    int gid = get_global_id(0);
+    float sum = 0.0f;
+    for (int i = 0; i < n; ++i)
+        sum += in[gid * n + i] * in[i];
+    out[gid] = sum;
+}
@@ -0,0 +1,38 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+// This test builds a program as the tier-0 binary of a tiered build. The
+// tier-1 build is queued in the background and usually still runs when ocloc
+// exits, which must neither hang nor crash. With TieredCompilationMaxResults=0
+// no tier-1 build is queued.
+
+// REQUIRES: regkeys
+
+// RUN: ocloc compile -file %s -internal_options "-cl-intel-tiered-compilation" -device dg2 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -internal_options "-ze-opt-tiered-compilation" -options "-cl-opt-disable" -device dg2 2>&1 | FileCheck %s
+// RUN: ocloc compile -file %s -internal_options "-cl-intel-tiered-compilation" -options " -igc_opts 'TieredCompilationMaxResults=0'" -device dg2 2>&1 | FileCheck %s
+
+// CHECK: Build succeeded.
+
+__kernel void saxpy(__global const float *x, __global float *y, float a, int n)
+{
+    for (int i = get_global_id(0); i < n; i += get_global_size(0))
+        y[i] = a * x[i] + y[i];
+}
+
+__kernel void histogram(__global const uchar *in, __global int *bins, __local int *local_bins, int n)
+{
+    int lid = get_local_id(0);
+    for (int i = lid; i < 256; i += get_local_size(0))
+        local_bins[i] = 0;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (int i = get_global_id(0); i < n; i += get_global_size(0))
+        atomic_inc(&local_bins[in[i]]);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for (int i = lid; i < 256; i += get_local_size(0))
+        atomic_add(&bins[i], local_bins[i]);
+}
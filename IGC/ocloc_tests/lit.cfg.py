@@ -39,7 +39,10 @@ llvm_config.with_environment('LD_LIBRARY_PATH', [config.ocloc_lib_dir,
                                                  config.cclang_lib_dir], append_path=True)
 
 
-tool_dirs = [config.ocloc_dir, config.llvm_tools_dir, config.spirv_as_dir]
+tool_dirs = [config.ocloc_dir, config.ocloc_concurrent_dir, config.llvm_tools_dir, config.spirv_as_dir]
+
+# Before ocloc, whose name it starts with.
+llvm_config.add_tool_substitutions([ToolSubst('ocloc_concurrent', unresolved='fatal')], tool_dirs)
 
 if llvm_config.add_tool_substitutions([ToolSubst('ocloc', unresolved='break')], tool_dirs) is False:
   lit_config.note('Did not find ocloc in %s, ocloc will be used from system paths' % tool_dirs)
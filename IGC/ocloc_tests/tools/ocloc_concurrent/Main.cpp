@@ -0,0 +1,157 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+// Stress test of concurrent compilations:
+//
+//   ocloc_concurrent <threads> <ocloc arguments>
+//
+// runs the ocloc command once, then on <threads> threads at once in the same
+// process, through the ocloc library, and fails if any of the concurrent runs
+// produces a different output than the first one. The source given with
+// -file is read once and passed to every run in memory. The log of the first
+// run is printed.
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace llvm;
+
+typedef int (*OclocInvokeTy)(unsigned int NumArgs, const char *Argv[],
+                             const uint32_t NumSources,
+                             const uint8_t **DataSources,
+                             const uint64_t *LenSources,
+                             const char **NameSources,
+                             const uint32_t NumInputHeaders,
+                             const uint8_t **DataInputHeaders,
+                             const uint64_t *LenInputHeaders,
+                             const char **NameInputHeaders,
+                             uint32_t *NumOutputs, uint8_t ***DataOutputs,
+                             uint64_t **LenOutputs, char ***NameOutputs);
+typedef int (*OclocFreeOutputTy)(uint32_t *NumOutputs, uint8_t ***DataOutputs,
+                                 uint64_t **LenOutputs, char ***NameOutputs);
+
+static const char *LogName = "stdout.log";
+
+struct Run {
+  int Status = -1;
+  // Output name -> contents.
+  std::map<std::string, std::string> Outputs;
+};
+
+static OclocInvokeTy OclocInvoke;
+static OclocFreeOutputTy OclocFreeOutput;
+
+static void invoke(const std::vector<const char *> &Args,
+                   const MemoryBuffer &Source, const char *SourceName,
+                   Run &R) {
+  std::vector<const char *> Argv = Args;
+  const uint8_t *Data =
+      reinterpret_cast<const uint8_t *>(Source.getBufferStart());
+  // ocloc expects the size to count the terminating null.
+  uint64_t Len = Source.getBufferSize() + 1;
+
+  uint32_t NumOutputs = 0;
+  uint8_t **DataOutputs = nullptr;
+  uint64_t *LenOutputs = nullptr;
+  char **NameOutputs = nullptr;
+  R.Status = OclocInvoke(Argv.size(), Argv.data(), 1, &Data, &Len,
+                         &SourceName, 0, nullptr, nullptr, nullptr,
+                         &NumOutputs, &DataOutputs, &LenOutputs, &NameOutputs);
+  for (uint32_t I = 0; I < NumOutputs; ++I)
+    R.Outputs[NameOutputs[I]] =
+        std::string(reinterpret_cast<const char *>(DataOutputs[I]),
+                    LenOutputs[I]);
+  OclocFreeOutput(&NumOutputs, &DataOutputs, &LenOutputs, &NameOutputs);
+}
+
+// Everything but the log, which may differ in the order of its lines.
+static bool sameOutputs(const Run &A, const Run &B) {
+  if (A.Status != B.Status)
+    return false;
+  auto skipLog = [](const std::map<std::string, std::string> &Outputs) {
+    std::map<std::string, std::string> Result = Outputs;
+    Result.erase(LogName);
+    return Result;
+  };
+  return skipLog(A.Outputs) == skipLog(B.Outputs);
+}
+
+int main(int argc, const char *argv[]) {
+  unsigned NumThreads = 0;
+  if (argc < 3 || StringRef(argv[1]).getAsInteger(10, NumThreads) ||
+      NumThreads == 0) {
+    errs() << "usage: " << argv[0] << " <threads> <ocloc arguments>\n";
+    return EXIT_FAILURE;
+  }
+
+  std::string Error;
+  auto Lib = sys::DynamicLibrary::getPermanentLibrary(OCLOC_LIBRARY_NAME,
+                                                      &Error);
+  if (!Lib.isValid()) {
+    errs() << "cannot load " << OCLOC_LIBRARY_NAME << ": " << Error << "\n";
+    return EXIT_FAILURE;
+  }
+  OclocInvoke =
+      reinterpret_cast<OclocInvokeTy>(Lib.getAddressOfSymbol("oclocInvoke"));
+  OclocFreeOutput = reinterpret_cast<OclocFreeOutputTy>(
+      Lib.getAddressOfSymbol("oclocFreeOutput"));
+  if (!OclocInvoke || !OclocFreeOutput) {
+    errs() << OCLOC_LIBRARY_NAME << " has no oclocInvoke/oclocFreeOutput\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<const char *> Args = {"ocloc"};
+  const char *SourceName = nullptr;
+  for (int I = 2; I < argc; ++I) {
+    Args.push_back(argv[I]);
+    if (StringRef(argv[I]) == "-file" && I + 1 < argc)
+      SourceName = argv[I + 1];
+  }
+  if (!SourceName) {
+    errs() << "no -file in the ocloc arguments\n";
+    return EXIT_FAILURE;
+  }
+  auto SourceOrErr = MemoryBuffer::getFile(SourceName, /*IsText=*/true);
+  if (!SourceOrErr) {
+    errs() << SourceName << ": " << SourceOrErr.getError().message() << "\n";
+    return EXIT_FAILURE;
+  }
+  const MemoryBuffer &Source = **SourceOrErr;
+
+  Run Serial;
+  invoke(Args, Source, SourceName, Serial);
+  outs() << Serial.Outputs[LogName];
+  outs().flush();
+
+  std::vector<Run> Runs(NumThreads);
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < NumThreads; ++I)
+    Threads.emplace_back(
+        [&, I]() { invoke(Args, Source, SourceName, Runs[I]); });
+  for (auto &T : Threads)
+    T.join();
+
+  int Status = Serial.Status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  for (unsigned I = 0; I < NumThreads; ++I) {
+    if (!sameOutputs(Serial, Runs[I])) {
+      errs() << "concurrent translation " << I << " of " << NumThreads
+             << " differs from the serial translation\n";
+      Status = EXIT_FAILURE;
+    }
+  }
+  return Status;
+}
@@ -8,6 +8,10 @@ SPDX-License-Identifier: MIT
 
 #include "Arena.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #ifdef COLLECT_ALLOCATION_STATS
 int numAllocations = 0;
 int numMallocCalls = 0;
@@ -46,9 +50,97 @@ void ArenaManager::FreeArenas() {
     currentMallocSize -= _arenas->size;
 #endif
     unsigned char *killed = (unsigned char *)_arenas;
+    size_t killedSize = ArenaHeader::GetArenaSize(_arenas->size);
     _arenas = _arenas->_nextArena;
-    delete[] killed;
+    ArenaChunkPool::freeChunk(killed, killedSize, _bytesRequested);
+    _bytesRequested = 0;
   }
 
   _arenas = 0;
 }
+
+namespace {
+struct ChunkCache {
+  std::unordered_map<size_t, std::vector<unsigned char *>> chunks;
+  size_t pooledBytes = 0;
+  ArenaStats stats;
+
+  ~ChunkCache();
+};
+
+// Set once the calling thread's cache is gone, for arenas that are freed
+// during thread or process exit after it.
+thread_local bool chunkCacheDestroyed = false;
+
+ChunkCache::~ChunkCache() {
+  for (auto &bucket : chunks)
+    for (auto chunk : bucket.second)
+      delete[] chunk;
+  chunkCacheDestroyed = true;
+}
+
+ChunkCache &getChunkCache() {
+  thread_local ChunkCache cache;
+  return cache;
+}
+} // namespace
+
+unsigned char *ArenaChunkPool::allocChunk(size_t size) {
+  if (chunkCacheDestroyed)
+    return new unsigned char[size];
+
+  ChunkCache &cache = getChunkCache();
+  unsigned char *chunk = nullptr;
+  auto it = cache.chunks.find(size);
+  if (it != cache.chunks.end() && !it->second.empty()) {
+    chunk = it->second.back();
+    it->second.pop_back();
+    cache.pooledBytes -= size;
+    cache.stats.chunksReused++;
+  } else {
+    chunk = new unsigned char[size];
+    cache.stats.chunksAllocated++;
+  }
+  cache.stats.liveBytes += size;
+  cache.stats.peakBytes =
+      std::max(cache.stats.peakBytes, cache.stats.liveBytes);
+  return chunk;
+}
+
+void ArenaChunkPool::freeChunk(unsigned char *chunk, size_t size,
+                               size_t requested) {
+  if (chunkCacheDestroyed) {
+    delete[] chunk;
+    return;
+  }
+
+  ChunkCache &cache = getChunkCache();
+  cache.stats.bytesRequested += requested;
+  // The chunk may come from another thread's arena.
+  cache.stats.liveBytes -= std::min(cache.stats.liveBytes, size);
+  if (size > MaxPooledChunkBytes ||
+      cache.pooledBytes + size > MaxPooledBytes) {
+    delete[] chunk;
+    return;
+  }
+  cache.chunks[size].push_back(chunk);
+  cache.pooledBytes += size;
+}
+
+const ArenaStats &ArenaChunkPool::getStats() {
+  return getChunkCache().stats;
+}
+
+size_t ArenaChunkPool::beginPhase() {
+  ArenaStats &stats = getChunkCache().stats;
+  size_t outerPeak = stats.peakBytes;
+  stats.peakBytes = stats.liveBytes;
+  return outerPeak;
+}
+
+size_t ArenaChunkPool::endPhase(size_t outerPeak) {
+  ArenaStats &stats = getChunkCache().stats;
+  size_t peak = stats.peakBytes;
+  stats.peakBytes = std::max(outerPeak, peak);
+  return peak;
+}
@@ -35,6 +35,44 @@ extern int currentMallocSize;
 
 namespace vISA {
 class Mem_Manager;
+
+// Arena memory statistics of the calling thread.
+struct ArenaStats {
+  // Bytes asked of arenas that have been freed since the thread started.
+  size_t bytesRequested = 0;
+  // Arena chunks taken from the system allocator and from the chunk pool.
+  size_t chunksAllocated = 0;
+  size_t chunksReused = 0;
+  // Bytes of the chunks currently held by arenas, and the highest that has
+  // been since the current phase began.
+  size_t liveBytes = 0;
+  size_t peakBytes = 0;
+};
+
+// Arena chunks are recycled through a per-thread pool instead of going back
+// to the system allocator, since a compile creates and frees arenas for every
+// kernel and every RA iteration. Chunks are pooled by size; only chunks of
+// at most MaxPooledChunkBytes are kept, which are those of the default-sized
+// arenas, and the pool keeps at most MaxPooledBytes. Whatever does not fit
+// is freed. A chunk may be freed on another thread than the one that
+// allocated it.
+class ArenaChunkPool {
+public:
+  static constexpr size_t MaxPooledChunkBytes = 64 * 1024;
+  static constexpr size_t MaxPooledBytes = 4 * 1024 * 1024;
+
+  static unsigned char *allocChunk(size_t size);
+  static void freeChunk(unsigned char *chunk, size_t size, size_t requested);
+
+  static const ArenaStats &getStats();
+
+  // Start a new phase for peak tracking: returns the peak so far, which is
+  // to be handed back to endPhase() so that the enclosing phase still sees
+  // it. endPhase() returns the peak of the phase that ends.
+  static size_t beginPhase();
+  static size_t endPhase(size_t outerPeak);
+};
+
 class ArenaHeader {
   friend class ArenaManager;
 
@@ -100,7 +138,7 @@ private:
   // Functions
 
   ArenaManager(size_t defaultArenaSize)
-      : _arenas(0), _defaultArenaSize(defaultArenaSize) {
+      : _arenas(0), _defaultArenaSize(defaultArenaSize), _bytesRequested(0) {
     CreateArena(_defaultArenaSize);
   }
 
@@ -113,6 +151,7 @@ private:
     return size == 0 ? 0 : malloc(size);
 #endif
     void *space = nullptr;
+    _bytesRequested += size;
 
     if (size) {
       space = _arenas->AllocSpace(size, al);
@@ -138,7 +177,7 @@ private:
         (size > _defaultArenaSize) ? size : _defaultArenaSize;
     arenaDataSize = ArenaHeader::DefaultAlign(arenaDataSize);
     unsigned char *arena =
-        new unsigned char[ArenaHeader::GetArenaSize(arenaDataSize)];
+        ArenaChunkPool::allocChunk(ArenaHeader::GetArenaSize(arenaDataSize));
 
     ArenaHeader *newArena = new (arena) ArenaHeader(arenaDataSize, _arenas);
     // Add new arena to the head of queue
@@ -174,6 +213,7 @@ private:
 
   ArenaHeader *_arenas;
   const size_t _defaultArenaSize;
+  size_t _bytesRequested;
 };
 } // namespace vISA
 #endif
@@ -165,25 +165,14 @@ static BITSET_ARRAY_TYPE maskTrailingZeros(unsigned n) {
   return ~maskTrailingOnes(n);
 }
 
-// TODO: Use c++20 bit manipulation utility functions.
 static unsigned countTrailingZeros(BITSET_ARRAY_TYPE val) {
   vASSERT(val != 0);
-  unsigned count = 0;
-  while ((val & 1) == 0) {
-    val >>= 1;
-    ++count;
-  }
-  return count;
+  return llvm::countTrailingZeros(val);
 }
 
 static unsigned countLeadingZeros(BITSET_ARRAY_TYPE val) {
   vASSERT(val != 0);
-  unsigned count = 0;
-  while ((val & (1 << (NUM_BITS_PER_ELT - 1))) == 0) {
-    val <<= 1;
-    ++count;
-  }
-  return count;
+  return llvm::countLeadingZeros(val);
 }
 
 int BitSet::findFirstIn(unsigned begin, unsigned end) const {
@@ -242,3 +231,16 @@ int BitSet::findLastIn(unsigned begin, unsigned end) const {
 
   return -1;
 }
+
+void TiledBitMatrix::init(unsigned numRows) {
+  unsigned numTileCols = (numRows + TileBits - 1) / TileBits;
+  rowOffsets.resize(numRows + 1);
+  uint32_t offset = 0;
+  for (unsigned row = 0; row < numRows; ++row) {
+    rowOffsets[row] = offset;
+    offset += numTileCols - row / TileBits;
+  }
+  rowOffsets[numRows] = offset;
+  tileHandles.assign(offset, 0);
+  tiles.clear();
+}
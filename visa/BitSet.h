@@ -10,13 +10,16 @@ SPDX-License-Identifier: MIT
 #define _BITSET_H_
 
 #include "Mem_Manager.h"
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <vector>
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
 #include "llvm/ADT/SparseBitVector.h"
+#include "llvm/Support/MathExtras.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
 
@@ -198,11 +201,7 @@ public:
     unsigned arraySize = (m_Size + NUM_BITS_PER_ELT - 1) / NUM_BITS_PER_ELT;
 
     for (unsigned i = 0; i < arraySize; i++) {
-      BITSET_ARRAY_TYPE value = m_BitSetArray[i];
-      while (value) {
-        ++count;
-        value = value & (value - 1);
-      }
+      count += llvm::countPopulation(m_BitSetArray[i]);
     }
     return count;
   }
@@ -896,4 +895,119 @@ public:
   }
 };
 
+// TiledBitMatrix is an upper-triangular bit matrix, (row, col) with row < col,
+// for graphs too large for a flat dense matrix. Every row is cut into tiles of
+// one cache line (512 bits) that are only allocated once one of their bits is
+// set. Dense regions of the matrix are thus stored as plain bit arrays that
+// are scanned a word at a time, while an empty tile only costs its handle.
+class TiledBitMatrix {
+public:
+  static constexpr unsigned TileBits = 512;
+  static constexpr unsigned TileWords = TileBits / 64;
+
+  TiledBitMatrix() = default;
+  TiledBitMatrix(const TiledBitMatrix &) = delete;
+  TiledBitMatrix &operator=(const TiledBitMatrix &) = delete;
+
+  void init(unsigned numRows);
+
+  void set(unsigned row, unsigned col) {
+    Tile &tile = getOrCreateTile(row, col / TileBits);
+    tile.words[(col % TileBits) / 64] |= uint64_t(1) << (col % 64);
+  }
+
+  void reset(unsigned row, unsigned col) {
+    if (Tile *tile = getTile(row, col / TileBits))
+      tile->words[(col % TileBits) / 64] &= ~(uint64_t(1) << (col % 64));
+  }
+
+  bool test(unsigned row, unsigned col) const {
+    const Tile *tile = getTile(row, col / TileBits);
+    return tile &&
+           (tile->words[(col % TileBits) / 64] >> (col % 64)) & 1;
+  }
+
+  // OR a 32-bit block of columns [32 * blockIdx, 32 * blockIdx + 32) into row.
+  void setBlock(unsigned row, unsigned blockIdx, uint32_t block) {
+    if (block == 0)
+      return;
+    unsigned col = blockIdx * 32;
+    Tile &tile = getOrCreateTile(row, col / TileBits);
+    tile.words[(col % TileBits) / 64] |= uint64_t(block) << (col % 64);
+  }
+
+  // Number of bits set in row.
+  unsigned count(unsigned row) const {
+    unsigned n = 0;
+    for (unsigned i = rowOffsets[row], e = rowOffsets[row + 1]; i != e; ++i) {
+      if (uint32_t handle = tileHandles[i]) {
+        const Tile &tile = tiles[handle - 1];
+        for (unsigned w = 0; w < TileWords; ++w)
+          n += llvm::countPopulation(tile.words[w]);
+      }
+    }
+    return n;
+  }
+
+  // Invoke fn(col) for every bit set in row, in increasing column order.
+  template <typename Fn> void forEach(unsigned row, Fn fn) const {
+    unsigned firstCol = (row / TileBits) * TileBits;
+    for (unsigned i = rowOffsets[row], e = rowOffsets[row + 1]; i != e;
+         ++i, firstCol += TileBits) {
+      uint32_t handle = tileHandles[i];
+      if (!handle)
+        continue;
+      const Tile &tile = tiles[handle - 1];
+      for (unsigned w = 0; w < TileWords; ++w) {
+        for (uint64_t bits = tile.words[w]; bits; bits &= bits - 1)
+          fn(firstCol + w * 64 + (unsigned)llvm::countTrailingZeros(bits));
+      }
+    }
+  }
+
+  unsigned getNumTiles() const { return (unsigned)tiles.size(); }
+  size_t getMemoryUsage() const {
+    return tiles.capacity() * sizeof(Tile) +
+           tileHandles.capacity() * sizeof(uint32_t) +
+           rowOffsets.capacity() * sizeof(uint32_t);
+  }
+
+private:
+  struct alignas(64) Tile {
+    uint64_t words[TileWords];
+  };
+
+  // Row i holds handles for tile columns [i / TileBits, numTileCols), stored
+  // at [rowOffsets[i], rowOffsets[i + 1]) in tileHandles. A handle is the
+  // index of the tile in tiles plus one, 0 meaning it is not allocated.
+  unsigned handleIndex(unsigned row, unsigned tileCol) const {
+    vASSERT(tileCol >= row / TileBits);
+    unsigned idx = rowOffsets[row] + tileCol - row / TileBits;
+    vASSERT(idx < rowOffsets[row + 1]);
+    return idx;
+  }
+
+  const Tile *getTile(unsigned row, unsigned tileCol) const {
+    uint32_t handle = tileHandles[handleIndex(row, tileCol)];
+    return handle ? &tiles[handle - 1] : nullptr;
+  }
+  Tile *getTile(unsigned row, unsigned tileCol) {
+    uint32_t handle = tileHandles[handleIndex(row, tileCol)];
+    return handle ? &tiles[handle - 1] : nullptr;
+  }
+
+  Tile &getOrCreateTile(unsigned row, unsigned tileCol) {
+    uint32_t &handle = tileHandles[handleIndex(row, tileCol)];
+    if (!handle) {
+      tiles.emplace_back();
+      handle = (uint32_t)tiles.size();
+    }
+    return tiles[handle - 1];
+  }
+
+  std::vector<uint32_t> rowOffsets;
+  std::vector<uint32_t> tileHandles;
+  std::vector<Tile> tiles;
+};
+
 #endif
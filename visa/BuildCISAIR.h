@@ -752,6 +752,11 @@ private:
           &callee2Callers,
       uint32_t options);
 
+  // Compiles the given kernels and functions up to stitching on up to
+  // numThreads threads (-finalizeThreads).
+  int compileConcurrently(const std::vector<VISAKernelImpl *> &kernels,
+                          unsigned numThreads);
+
   void emitFCPatchFile();
 };
 
@@ -27,7 +27,9 @@ SPDX-License-Identifier: MIT
 #include "IsaVerification.h"
 #include "IGC/common/StringMacros.hpp"
 #include "MetadataDumpRA.h"
+#include "Parallel.h"
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -36,6 +38,7 @@ SPDX-License-Identifier: MIT
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
@@ -228,13 +231,13 @@ int CISA_IR_Builder::CreateBuilder(CISA_IR_Builder *&builder,
                                    const char *flags[],
                                    const WA_TABLE *pWaTable) {
 
-  initTimer();
-
   if (builder) {
     vASSERT(builder == nullptr);
     return VISA_FAILURE;
   }
 
+  holdTimers();
+
   startTimer(TimerID::TOTAL);
   startTimer(TimerID::BUILDER); // builder time ends with we call compile (i.e.,
                                 // it covers the IR construction time)
@@ -249,6 +252,7 @@ int CISA_IR_Builder::CreateBuilder(CISA_IR_Builder *&builder,
 
   if (!builder->m_options.parseOptions(numArgs, flags)) {
     delete builder;
+    releaseTimers();
     vISA_ASSERT(false, "parsing error");
     return VISA_FAILURE;
   }
@@ -336,6 +340,7 @@ int CISA_IR_Builder::DestroyBuilder(CISA_IR_Builder *builder) {
   }
 
   delete builder;
+  releaseTimers();
 
   return VISA_SUCCESS;
 }
@@ -1546,6 +1551,58 @@ int CISA_IR_Builder::ParseVISAText(const std::string &visaFile) {
 
 }
 
+// Compiles kernels and functions up to the point they get stitched (see
+// -finalizeThreads) on up to numThreads threads, and returns the status of the
+// first one in order that failed. Each of them is optimized and register
+// allocated by its own IR_Builder out of its own memory and, when they run
+// concurrently, with its own copy of the builder's options, which some passes
+// change while they compile. The critical messages are kept per kernel and
+// appended in order afterwards.
+int CISA_IR_Builder::compileConcurrently(
+    const std::vector<VISAKernelImpl *> &kernels, unsigned numThreads) {
+  // The options a kernel's compilation may change for all the others must
+  // be settled before they start. Mixing targets would make that depend on
+  // the order, so such builders are compiled in order.
+  bool sameTarget = std::all_of(
+      kernels.begin(), kernels.end(), [&](VISAKernelImpl *kernel) {
+        return kernel->getKernel()->getInt32KernelAttr(
+                   Attributes::ATTR_Target) ==
+               kernels.front()->getKernel()->getInt32KernelAttr(
+                   Attributes::ATTR_Target);
+      });
+  if (!sameTarget)
+    numThreads = 1;
+  for (VISAKernelImpl *kernel : kernels)
+    kernel->getKernel()->fg.updateScalarJmpOption();
+  if (numThreads > 1) {
+    for (VISAKernelImpl *kernel : kernels)
+      kernel->useOwnOptions();
+  }
+
+  std::vector<int> statuses(kernels.size(), VISA_SUCCESS);
+  auto compileKernel = [&](size_t i) {
+    kernels[i]->getIRBuilder()->useLocalCriticalMsg();
+    statuses[i] = kernels[i]->compileFastPath();
+  };
+  if (numThreads <= 1) {
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      compileKernel(i);
+      if (statuses[i] != VISA_SUCCESS)
+        break;
+    }
+  } else {
+    vISA::parallelFor(numThreads, kernels.size(), compileKernel);
+  }
+
+  int status = VISA_SUCCESS;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    criticalMsg << kernels[i]->getIRBuilder()->takeLocalCriticalMsg();
+    if (status == VISA_SUCCESS)
+      status = statuses[i];
+  }
+  return status;
+}
+
 // default size of the kernel mem manager in bytes
 int CISA_IR_Builder::Compile(const char *isaasmFileName, bool emit_visa_only) {
   // TIMER_BUILDER is started when builder is created
@@ -1655,6 +1712,13 @@ int CISA_IR_Builder::Compile(const char *isaasmFileName, bool emit_visa_only) {
     uint32_t localScheduleEndKernelId =
         m_options.getuInt32Option(vISA_LocalScheduleingEndKernel);
     VISAKernelImpl *mainKernel = nullptr;
+    // With -finalizeThreads, the kernels and functions are only prepared
+    // here and compiled all at once below.
+    unsigned finalizeThreads = m_options.getuInt32Option(vISA_FinalizeThreads);
+    bool deferCompile = finalizeThreads > 1 && m_kernel_count + m_function_count > 1 &&
+                        !m_options.getuInt32Option(vISA_CodePatch) &&
+                        !m_options.getOption(vISA_forceBCR);
+    std::vector<VISAKernelImpl *> deferredKernels;
     KernelListTy::iterator iter = kernel_begin();
     KernelListTy::iterator iend = kernel_end();
     for (int i = 0; iter != iend; iter++, i++) {
@@ -1712,6 +1776,10 @@ int CISA_IR_Builder::Compile(const char *isaasmFileName, bool emit_visa_only) {
           (kernel->getvIsaInstCount() == 0 && kernel->getIsPayload())) {
         continue;
       }
+      if (deferCompile) {
+        deferredKernels.push_back(kernel);
+        continue;
+      }
       int status = kernel->compileFastPath();
       if (status != VISA_SUCCESS) {
         stopTimer(TimerID::TOTAL);
@@ -1735,6 +1803,15 @@ int CISA_IR_Builder::Compile(const char *isaasmFileName, bool emit_visa_only) {
         }
       }
     }
+    if (!deferredKernels.empty()) {
+      int status = compileConcurrently(deferredKernels, finalizeThreads);
+      if (status != VISA_SUCCESS) {
+        stopTimer(TimerID::TOTAL);
+        if (status == VISA_EARLY_EXIT)
+          status = VISA_SUCCESS;
+        return status;
+      }
+    }
     // Here we change the payload section as the main kernel in
     // m_kernelsAndFunctions During stitching, all functions will be cloned and
     // stitched to the main kernel. Demoting the shader body to a function type
@@ -3951,6 +4028,8 @@ void CISA_IR_Builder::CISA_post_file_parse() { return; }
 // place it here so that internal Gen_IR files don't have to include
 // VISAKernel.h
 std::stringstream &IR_Builder::criticalMsgStream() {
+  if (localCriticalMsg)
+    return *localCriticalMsg;
   return const_cast<CISA_IR_Builder *>(parentBuilder)->criticalMsgStream();
 }
 
@@ -12,8 +12,10 @@ SPDX-License-Identifier: MIT
 #include <cstdarg>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 
 #include "Assertions.h"
@@ -440,6 +442,10 @@ private:
 
   const CISA_IR_Builder *parentBuilder = nullptr;
 
+  // Critical messages of the kernel while it's compiled concurrently with
+  // the other kernels of the parent builder (see -finalizeThreads).
+  std::unique_ptr<std::stringstream> localCriticalMsg;
+
   // stores all metadata ever allocated
   Mem_Manager metadataMem;
   std::vector<Metadata *> allMDs;
@@ -477,10 +483,15 @@ public:
   unsigned num_temp_dcl;
   // number of temp GRF vars created to hold spilled addr/flag
   uint32_t numAddrFlagSpillLoc = 0;
+  // number of dcls created by cloneDeclare, for their names
+  uint32_t numClonedDcl = 0;
+  // number of temp dsts created to split sampler messages, for their names
+  uint32_t numTmpSmplDst = 0;
   std::vector<input_info_t *> m_inputVect;
   BitSet src1FirstGRFOfLastDpas;
 
   const Options *getOptions() const { return m_options; }
+  void setOptions(Options *options) { m_options = options; }
   bool getOption(vISAOptions opt) const { return m_options->getOption(opt); }
   uint32_t getuint32Option(vISAOptions opt) const {
     return m_options->getuInt32Option(opt);
@@ -498,6 +509,16 @@ public:
   void dump(std::ostream &os); // not const because G4_INST::emit isn't :(
 
   std::stringstream &criticalMsgStream();
+  // Redirects criticalMsgStream() to a stream of this kernel's own until
+  // takeLocalCriticalMsg() returns its contents.
+  void useLocalCriticalMsg() {
+    localCriticalMsg = std::make_unique<std::stringstream>();
+  }
+  std::string takeLocalCriticalMsg() {
+    std::string msg = localCriticalMsg ? localCriticalMsg->str() : "";
+    localCriticalMsg.reset();
+    return msg;
+  }
 
   const USE_DEF_ALLOCATOR &getAllocator() const { return useDefAllocator; }
 
@@ -794,9 +794,8 @@ IR_Builder::~IR_Builder() {
 G4_Declare *
 IR_Builder::cloneDeclare(std::map<G4_Declare *, G4_Declare *> &dclMap,
                          G4_Declare *dcl) {
-  static int uid = 0;
   const char *newDclName =
-      getNameString(16, "copy_%d_%s", uid++, dcl->getName());
+      getNameString(16, "copy_%u_%s", numClonedDcl++, dcl->getName());
   return dclpool.cloneDeclare(kernel, dclMap, newDclName, dcl);
 }
 
@@ -45,7 +45,10 @@ SPDX-License-Identifier: MIT
 
 #include "VISAKernel.h"
 
+#include <cstdint>
 #include <list>
+#include <string>
+#include <vector>
 
 // bfi can have 7 operands
 #define COMMON_ISA_MAX_NUM_OPND_ARITH_LOGIC 7
@@ -2918,12 +2921,18 @@ static void readRoutineNG(unsigned &bytePos, const char *buf,
 }
 
 #define READ_FIELD_FROM_BUF(dst, type)                                         \
+  if ((size_t)byte_pos + sizeof(type) > size)                                  \
+    return 1;                                                                  \
   dst = *((type *)&buf[byte_pos]);                                             \
   byte_pos += sizeof(type);
 
+// Returns non-zero if the header does not fit in the size bytes of
+// cisaBuffer. Callers that do not know the size of the buffer leave it at
+// SIZE_MAX.
 static int processCommonISAHeader(common_isa_header &cisaHdr,
                                   unsigned &byte_pos, const void *cisaBuffer,
-                                  vISA::Mem_Manager *mem) {
+                                  vISA::Mem_Manager *mem,
+                                  size_t size = SIZE_MAX) {
   const char *buf = (const char *)cisaBuffer;
   READ_FIELD_FROM_BUF(cisaHdr.magic_number, uint32_t);
   READ_FIELD_FROM_BUF(cisaHdr.major_version, uint8_t);
@@ -2947,6 +2956,8 @@ static int processCommonISAHeader(common_isa_header &cisaHdr,
     } else {
       READ_FIELD_FROM_BUF(cisaHdr.kernels[i].name_len, uint16_t);
     }
+    if ((size_t)byte_pos + cisaHdr.kernels[i].name_len > size)
+      return 1;
     cisaHdr.kernels[i].name =
         (char *)mem->alloc(cisaHdr.kernels[i].name_len + 1);
     memcpy_s(cisaHdr.kernels[i].name,
@@ -3008,6 +3019,8 @@ static int processCommonISAHeader(common_isa_header &cisaHdr,
     } else {
       READ_FIELD_FROM_BUF(cisaHdr.functions[i].name_len, uint16_t);
     }
+    if ((size_t)byte_pos + cisaHdr.functions[i].name_len > size)
+      return 1;
     cisaHdr.functions[i].name =
         (char *)mem->alloc(cisaHdr.functions[i].name_len + 1);
     memcpy_s(cisaHdr.functions[i].name,
@@ -3037,6 +3050,39 @@ static int processCommonISAHeader(common_isa_header &cisaHdr,
   return 0;
 }
 
+//
+// Reads only the header of the vISA binary in buf and returns the names of
+// its kernels, so that a caller replaying a large .isa file can pick the
+// kernels to decode with readIsaBinaryNG() without touching the rest of it.
+// Returns false if the header or any routine it describes does not fit in the
+// size bytes of buf.
+//
+bool readIsaBinaryKernelNamesNG(const char *buf, size_t size,
+                                std::vector<std::string> &kernelNames) {
+  vISA_ASSERT(buf != nullptr, "Argument Exception: argument buf  is NULL.");
+
+  unsigned bytePos = 0;
+  vISA::Mem_Manager binaryReaderMem(4096);
+  common_isa_header isaHeader;
+  isaHeader.num_functions = 0;
+
+  if (processCommonISAHeader(isaHeader, bytePos, buf, &binaryReaderMem, size))
+    return false;
+
+  for (unsigned i = 0; i < isaHeader.num_kernels; i++) {
+    const kernel_info_t &kernel = isaHeader.kernels[i];
+    if ((size_t)kernel.offset + kernel.size > size)
+      return false;
+    kernelNames.emplace_back(kernel.name, kernel.name_len);
+  }
+  for (unsigned i = 0; i < isaHeader.num_functions; i++) {
+    const function_info_t &func = isaHeader.functions[i];
+    if ((size_t)func.offset + func.size > size)
+      return false;
+  }
+  return true;
+}
+
 //
 // buf -- vISA binary to be processed.  For offline compile it's always the
 // entire vISA object.
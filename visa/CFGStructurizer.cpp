@@ -403,7 +403,8 @@ public:
 
 // 0:  default, dumps only CF related instructions (CF instr, label)
 // 1:  All instructions
-static int dump_level = 0;
+// Per thread, as kernels may be structurized concurrently.
+static thread_local int dump_level = 0;
 static const char *currFileName = nullptr;
 static std::ofstream dump_ofs;
 static std::ostream *dumpOut = &std::cout; // default
@@ -22,6 +22,7 @@ SPDX-License-Identifier: MIT
 #include "iga/IGALibrary/api/iga.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
@@ -261,6 +262,7 @@ void FlowGraph::append(const FlowGraph &otherFG) {
 
   for (auto I = otherFG.cbegin(), E = otherFG.cend(); I != E; ++I) {
     auto bb = *I;
+    bb->setInstListAllocator(instListAlloc);
     BBs.push_back(bb);
     incrementNumBBs();
   }
@@ -354,7 +356,8 @@ G4_BB *FlowGraph::createNewBBWithLabel(const char *LabelSuffix) {
   return newBB;
 }
 
-static int globalCount = 1;
+// Shared by the kernels compiled concurrently.
+static std::atomic<int> globalCount{1};
 
 int64_t FlowGraph::insertDummyUUIDMov() {
   // Here when -addKernelId is passed
@@ -372,8 +375,7 @@ int64_t FlowGraph::insertDummyUUIDMov() {
       uint32_t seed = (uint32_t)std::chrono::high_resolution_clock::now()
                           .time_since_epoch()
                           .count();
-      std::mt19937 mt_rand(seed * globalCount);
-      globalCount++;
+      std::mt19937 mt_rand(seed * globalCount++);
 
       G4_DstRegRegion *nullDst = builder->createNullDst(Type_UD);
       int64_t uuID = (int64_t)mt_rand();
@@ -622,6 +624,16 @@ void FlowGraph::normalizeFlowGraph() {
 // label is visited.
 //
 //
+// CM kernels don't use scalar jmp on fused EU platforms. Note that this
+// turns it off in the options shared by all the kernels of the builder.
+void FlowGraph::updateScalarJmpOption() {
+  if (builder->hasFusedEU() && !builder->getOption(vISA_KeepScalarJmp) &&
+      getKernel()->getInt32KernelAttr(Attributes::ATTR_Target) == VISA_CM &&
+      builder->getOption(vISA_EnableScalarJmp)) {
+    getKernel()->getOptions()->setOptionInternally(vISA_EnableScalarJmp, false);
+  }
+}
+
 void FlowGraph::constructFlowGraph(INST_LIST &instlist) {
   //vISA_ASSERT(!instlist.empty(), ERROR_SYNTAX("empty instruction list"));
   setCurrentDebugPass("CFG");
@@ -632,10 +644,7 @@ void FlowGraph::constructFlowGraph(INST_LIST &instlist) {
     // done before RA ToDo: just hard-wire the scratch-surface offset register?
     builder->initScratchSurfaceOffset();
   }
-  if (builder->hasFusedEU() && !builder->getOption(vISA_KeepScalarJmp) &&
-      getKernel()->getInt32KernelAttr(Attributes::ATTR_Target) == VISA_CM) {
-    getKernel()->getOptions()->setOptionInternally(vISA_EnableScalarJmp, false);
-  }
+  updateScalarJmpOption();
 
   //
   // The funcInfoHashTable maintains a map between the id of the function's INIT
@@ -1942,8 +1951,7 @@ void FlowGraph::removeRedundantLabels() {
 
           // remove bb's label before splice
           bb->remove(labelInst);
-          singlePred->getInstList().splice(singlePred->end(),
-                                           bb->getInstList());
+          singlePred->splice(singlePred->end(), bb);
 
           bb->Succs.clear();
           bb->Preds.clear();
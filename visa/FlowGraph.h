@@ -509,10 +509,13 @@ public:
   void recomputePreId(BBIDMap &IDMap);
 
   void constructFlowGraph(INST_LIST &instlist);
+  void updateScalarJmpOption();
   bool matchBranch(int &sn, INST_LIST &instlist, INST_LIST_ITER &it);
 
   void localDataFlowAnalysis();
+  void localDataFlowAnalysis(G4_BB *bb);
   void resetLocalDataFlowData();
+  void rebuildLocalDataFlow(G4_BB *bb);
 
   unsigned getNumBB() const { return numBBId; }
   G4_BB *getEntryBB() { return BBs.front(); }
@@ -256,10 +256,10 @@ void G4_BB::emitInstructionSourceLineMapping(std::ostream &output,
                                              INST_LIST_ITER &it) {
   // We record the previous instruction's source code locations so that they are
   // emitted only when there's a change.
-  // Using global variables is ok here since this function is for shader dumps
-  // (i.e., debugging) only.
-  static const char *prevFilename = nullptr;
-  static int prevSrcLineNo = 0;
+  // A kernel is dumped on a single thread, but kernels may be compiled (and
+  // dumped) concurrently, so the previous locations are kept per thread.
+  static thread_local const char *prevFilename = nullptr;
+  static thread_local int prevSrcLineNo = 0;
 
   const char *curFilename = (*it)->getSrcFilename();
   int curSrcLineNo = (*it)->getLineNo();
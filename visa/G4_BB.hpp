@@ -155,27 +155,43 @@ public:
 
   // splice functions below expect caller to have correctly set CISA offset
   // in instructions to be spliced. CISA offsets must be maintained to
-  // preserve debug info links.
+  // preserve debug info links. Both lists must have the same node allocator
+  // (see std_arena_based_node_allocator).
   void splice(INST_LIST::iterator pos, INST_LIST &other) {
+    vISA_ASSERT(canSpliceFrom(other), "splice with another node allocator");
     instList.splice(pos, other);
   }
   void splice(INST_LIST::iterator pos, G4_BB *otherBB) {
-    instList.splice(pos, otherBB->getInstList());
+    splice(pos, otherBB->getInstList());
   }
   void splice(INST_LIST::iterator pos, INST_LIST &other,
               INST_LIST::iterator it) {
+    vISA_ASSERT(canSpliceFrom(other), "splice with another node allocator");
     instList.splice(pos, other, it);
   }
   void splice(INST_LIST::iterator pos, G4_BB *otherBB, INST_LIST::iterator it) {
-    instList.splice(pos, otherBB->getInstList(), it);
+    splice(pos, otherBB->getInstList(), it);
   }
   void splice(INST_LIST::iterator pos, INST_LIST &other,
               INST_LIST::iterator first, INST_LIST::iterator last) {
+    vISA_ASSERT(canSpliceFrom(other), "splice with another node allocator");
     instList.splice(pos, other, first, last);
   }
   void splice(INST_LIST::iterator pos, G4_BB *otherBB,
               INST_LIST::iterator first, INST_LIST::iterator last) {
-    instList.splice(pos, otherBB->getInstList(), first, last);
+    splice(pos, otherBB->getInstList(), first, last);
+  }
+  bool canSpliceFrom(const INST_LIST &other) const {
+    return instList.get_allocator() == other.get_allocator();
+  }
+  // Move the instructions to nodes of alloc, e.g., when the BB is appended to
+  // another kernel's flow graph, so that they can be spliced with that
+  // kernel's lists.
+  void setInstListAllocator(const INST_LIST_NODE_ALLOCATOR &alloc) {
+    if (instList.get_allocator() == alloc)
+      return;
+    INST_LIST insts(instList.begin(), instList.end(), alloc);
+    instList.swap(insts);
   }
 
   //
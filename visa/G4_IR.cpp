@@ -4912,12 +4912,16 @@ PhyRegPool::PhyRegPool(Mem_Manager &m, unsigned int maxRegisterNumber) {
 }
 
 void PhyRegPool::rebuildRegPool(Mem_Manager &m, unsigned int numRegisters) {
+  G4_Greg **oldTable = GRF_Table;
+  unsigned int oldNum = maxGRFNum;
   maxGRFNum = numRegisters;
 
   GRF_Table = (G4_Greg **)m.alloc(sizeof(G4_Greg *) * maxGRFNum);
-  // create General Registers
+  // Keep the registers that are already in the pool, as operands assigned
+  // before the rebuild (e.g., by RA when it moves to a larger GRF mode)
+  // still point to them.
   for (unsigned int i = 0; i < maxGRFNum; i++)
-    GRF_Table[i] = new (m) G4_Greg(i);
+    GRF_Table[i] = i < oldNum ? oldTable[i] : new (m) G4_Greg(i);
 }
 
 G4_Declare::G4_Declare(const IR_Builder &builder, const char *n,
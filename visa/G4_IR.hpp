@@ -61,7 +61,7 @@ class G4_PseudoAddrMovIntrinsic;
 
 vISA::G4_Declare *GetTopDclFromRegRegion(vISA::G4_Operand *opnd);
 
-typedef vISA::std_arena_based_allocator<vISA::G4_INST *>
+typedef vISA::std_arena_based_node_allocator<vISA::G4_INST *>
     INST_LIST_NODE_ALLOCATOR;
 
 typedef std::list<vISA::G4_INST *, INST_LIST_NODE_ALLOCATOR> INST_LIST;
@@ -73,7 +73,7 @@ typedef std::list<vISA::G4_INST *, INST_LIST_NODE_ALLOCATOR>::reverse_iterator
     INST_LIST_RITER;
 
 typedef std::pair<vISA::G4_INST *, Gen4_Operand_Number> USE_DEF_NODE;
-typedef vISA::std_arena_based_allocator<USE_DEF_NODE> USE_DEF_ALLOCATOR;
+typedef vISA::std_arena_based_node_allocator<USE_DEF_NODE> USE_DEF_ALLOCATOR;
 
 typedef std::list<USE_DEF_NODE, USE_DEF_ALLOCATOR> USE_EDGE_LIST;
 typedef std::list<USE_DEF_NODE, USE_DEF_ALLOCATOR>::iterator USE_EDGE_LIST_ITER;
@@ -121,6 +121,7 @@ class VarSplitPass;
 class GRFMode {
 public:
   GRFMode(const TARGET_PLATFORM platform, Options *op);
+  void setOptions(Options *op) { options = op; }
 
   void setModeByNumGRFs(unsigned grfs) {
     unsigned size = configs.size();
@@ -595,6 +596,10 @@ public:
 
   Options *getOptions() { return m_options; }
   const Options *getOptions() const { return m_options; }
+  void setOptions(Options *options) {
+    m_options = options;
+    grfMode.setOptions(options);
+  }
 
   const Attributes *getKernelAttrs() const { return m_kernelAttrs; }
   bool getBoolKernelAttr(Attributes::ID aID) const {
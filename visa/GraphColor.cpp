@@ -65,6 +65,7 @@ Interference::Interference(const LivenessAnalysis *l, GlobalRA &g)
       incRA(g.incRA), sparseMatrix(g.intfStorage.sparseMatrix),
       sparseIntf(g.intfStorage.sparseIntf) {
   denseMatrixLimit = builder.getuint32Option(vISA_DenseMatrixLimit);
+  tiledMatrixLimit = builder.getuint32Option(vISA_TiledMatrixLimit);
   incRA.registerNextIter((G4_RegFileKind)l->getSelectedRF(), l, this);
 }
 
@@ -1532,6 +1533,8 @@ bool Interference::interfereBetween(unsigned v1, unsigned v2) const {
   if (useDenseMatrix()) {
     unsigned col = v2 / BITS_DWORD;
     return matrix[v1 * rowSize + col] & (1 << (v2 % BITS_DWORD));
+  } else if (useTiledMatrix()) {
+    return tiledMatrix.test(v1, v2);
   } else {
     auto &set1 = sparseMatrix[v1];
     return set1.test(v2);
@@ -2484,6 +2487,7 @@ void Interference::computeInterference() {
     RPE rpe(gra, liveAnalysis);
     rpe.run();
     std::cout << "\t--max RP: " << rpe.getMaxRP() << "\n";
+    dumpMatrixFootprint();
   });
 
   if ((builder.getOption(vISA_RATrace) ||
@@ -2538,6 +2542,10 @@ void Interference::getNormIntfNum() {
         }
       }
     }
+  } else if (useTiledMatrix()) {
+    for (uint32_t v1 = 0; v1 < maxId; ++v1) {
+      numEdges += tiledMatrix.count(v1);
+    }
   } else {
     for (uint32_t v1 = 0; v1 < maxId; ++v1) {
       auto &intfSet = sparseMatrix[v1];
@@ -2581,6 +2589,13 @@ void Interference::generateSparseIntfGraph() {
         }
       }
     }
+  } else if (useTiledMatrix()) {
+    for (uint32_t v1 = 0; v1 < maxId; ++v1) {
+      tiledMatrix.forEach(v1, [&](unsigned v2) {
+        sparseIntf[v1].emplace_back(v2);
+        sparseIntf[v2].emplace_back(v1);
+      });
+    }
   } else {
     for (uint32_t v1 = 0; v1 < maxId; ++v1) {
       auto &intfSet = sparseMatrix[v1];
@@ -9412,6 +9427,7 @@ int GlobalRA::coloringRegAlloc() {
   }
 
   bool rematDone = false, alignedScalarSplitDone = false;
+  bool largerGRFDone = false;
   bool reserveSpillReg = false;
   VarSplit splitPass(*this);
   DynPerfModel perfModel(kernel);
@@ -9664,6 +9680,25 @@ int GlobalRA::coloringRegAlloc() {
           continue;
         }
 
+        // Coloring still fails with the GRF mode picked by the pre-RA
+        // pressure estimate. Rather than spilling, or failing the kernel so
+        // that the driver recompiles it from scratch with more GRFs, move to
+        // the next larger GRF mode and color again. This is done once: if
+        // that mode isn't enough either, spill as usual. The forbidden
+        // templates and the coloring are rebuilt for the new GRF count in
+        // the next iteration. Stack call ABI registers are placed relative
+        // to the GRF count before RA, so such kernels are left alone.
+        if (iterationNo == 0 && !largerGRFDone && !hasStackCall &&
+            kernel.getOption(vISA_RALargerGRFOnSpill) &&
+            kernel.useRegSharingHeuristics() && !useHybridRAwithSpill &&
+            kernel.updateKernelToLargerGRF()) {
+          RA_TRACE(std::cout << "\t--retry with " << kernel.getNumRegTotal()
+                             << " GRFs\n");
+          largerGRFDone = true;
+          incRA.skipIncrementalRANextIter();
+          continue;
+        }
+
         if (!kernel.getOption(vISA_Debug) && iterationNo == 0 && !fastCompile &&
             kernel.getOption(vISA_DoSplitOnSpill)) {
           RA_TRACE(std::cout << "\t--var split around loop\n");
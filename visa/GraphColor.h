@@ -622,7 +622,13 @@ class Interference {
   // cache behavior
   std::vector<llvm_SBitVector>& sparseMatrix;
 
+  // Tiled interference matrix, used in place of sparseMatrix when there are
+  // too many variables for the dense matrix but few enough that a tile
+  // handle per 512 columns of the upper half is cheap.
+  TiledBitMatrix tiledMatrix;
+
   unsigned int denseMatrixLimit = 0;
+  unsigned int tiledMatrixLimit = 0;
 
   static void updateLiveness(llvm_SBitVector &live, uint32_t id, bool val) {
     if (val) {
@@ -640,6 +646,8 @@ class Interference {
     if (useDenseMatrix()) {
       unsigned col = v2 / BITS_DWORD;
       matrix[v1 * rowSize + col] |= 1 << (v2 % BITS_DWORD);
+    } else if (useTiledMatrix()) {
+      tiledMatrix.set(v1, v2);
     } else {
       sparseMatrix[v1].set(v2);
     }
@@ -650,6 +658,8 @@ class Interference {
     if (useDenseMatrix()) {
       unsigned col = v2 / BITS_DWORD;
       matrix[v1 * rowSize + col] &= ~(1 << (v2 % BITS_DWORD));
+    } else if (useTiledMatrix()) {
+      tiledMatrix.reset(v1, v2);
     } else {
       sparseMatrix[v1].reset(v2);
     }
@@ -665,6 +675,8 @@ class Interference {
 #endif
 
       matrix[v1 * rowSize + col] |= block;
+    } else if (useTiledMatrix()) {
+      tiledMatrix.setBlock(v1, col, block);
     } else {
       auto &&intfSet = sparseMatrix[v1];
       for (int i = 0; i < BITS_DWORD; ++i) {
@@ -712,6 +724,7 @@ class Interference {
 
   void generateSparseIntfGraph();
   void countNeighbors();
+  void dumpMatrixFootprint() const;
 
   void setupLRs(G4_BB *bb);
 
@@ -734,6 +747,14 @@ public:
     return (maxId < denseMatrixLimit) && (size < max);
   }
 
+  bool useTiledMatrix() const {
+    return !useDenseMatrix() && maxId < tiledMatrixLimit;
+  }
+
+  bool useSparseMatrix() const {
+    return !useDenseMatrix() && !useTiledMatrix();
+  }
+
   const std::vector<G4_Declare *> *
   getCompatibleSparseIntf(G4_Declare *d) const {
     if (compatibleSparseIntf.size() > 0) {
@@ -750,6 +771,8 @@ public:
     if (useDenseMatrix()) {
       auto N = (size_t)rowSize * (size_t)maxId;
       matrix = new uint32_t[N](); // zero-initialize
+    } else if (useTiledMatrix()) {
+      tiledMatrix.init(maxId);
     } else {
       sparseMatrix.resize(maxId);
     }
@@ -4650,7 +4650,7 @@ void HWConformity::DPASWA(G4_BB *bb, DPASSrc2RSCache *src2GRFCache) {
   }
 }
 
-void HWConformity::localizeForAcc(G4_BB *bb) {
+bool HWConformity::localizeForAcc(G4_BB *bb) {
   std::map<const G4_Declare *, G4_Operand *> replacedOperand;
   std::unordered_map<const G4_Declare *, std::vector<struct LiveNode>> useNodes;
   std::vector<const G4_Declare *> erasedCandidates;
@@ -4727,7 +4727,7 @@ void HWConformity::localizeForAcc(G4_BB *bb) {
     }
   }
 
-  return;
+  return !replacedOperand.empty();
 }
 
 // convert a psuedo mad inst into mul/add
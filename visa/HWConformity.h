@@ -256,7 +256,8 @@ public:
   bool checkDPASSrcDstOverlap(INST_LIST_ITER iter, G4_BB *bb);
   G4_INST *evenlySplitDPAS8x8Inst(INST_LIST_ITER iter, G4_BB *bb);
   void DPASWA(G4_BB *bb, DPASSrc2RSCache *src2GRFCache);
-  void localizeForAcc(G4_BB *bb);
+  // Returns true if any global operand of bb was localized.
+  bool localizeForAcc(G4_BB *bb);
   void splitDWMULInst(INST_LIST_ITER &start, INST_LIST_ITER &end, G4_BB *bb);
   void fixMulSrc1(INST_LIST_ITER i, G4_BB *bb);
 };
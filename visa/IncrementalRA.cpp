@@ -93,8 +93,8 @@ void IncrementalRA::registerNextIter(G4_RegFileKind rf,
     return;
   }
 
-  // TODO: Add support for dense intf matrix
-  if (intf->useDenseMatrix()) {
+  // TODO: Add support for dense and tiled intf matrix
+  if (!intf->useSparseMatrix()) {
     reset();
     return;
   }
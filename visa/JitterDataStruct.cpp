@@ -23,7 +23,8 @@ llvm::json::Value toJSON(const PERF_STATS &p) {
     {"numGRFSpillFill", p.numGRFSpillFillWeighted},
     {"GRFSpillSize", p.spillMemUsed},
     {"numCycles", p.numCycles},
-    {"maxGRFPressure", p.maxGRFPressure}
+    {"maxGRFPressure", p.maxGRFPressure},
+    {"cyclesPerWorkItem", p.cyclesPerWorkItem}
   };
 }
 
@@ -52,6 +53,13 @@ llvm::json::Value toJSON(const PERF_STATS_VERBOSE &p) {
     jsonObject.insert({"normIntfNum", p.normIntfNum});
     jsonObject.insert({"augIntfNum", p.augIntfNum});
   }
+  if (p.arenaChunksAllocated || p.arenaChunksReused) {
+    jsonObject.insert({"arenaBytesRequested", p.arenaBytesRequested});
+    jsonObject.insert({"arenaChunksAllocated", p.arenaChunksAllocated});
+    jsonObject.insert({"arenaChunksReused", p.arenaChunksReused});
+    jsonObject.insert({"arenaPeakBytes", p.arenaPeakBytes});
+    jsonObject.insert({"arenaRAPeakBytes", p.arenaRAPeakBytes});
+  }
 
   return jsonObject;
 }
@@ -485,53 +485,56 @@ static void processWriteOpnds(G4_BB *BB, G4_INST *Inst,
   }
 }
 
-void FlowGraph::localDataFlowAnalysis() {
-  for (auto BB : BBs) {
-    LocalLivenessInfo LLI(!BB->isAllLaneActive());
-    for (auto I = BB->rbegin(), E = BB->rend(); I != E; ++I) {
-      G4_INST *Inst = *I;
-      G4_opcode Op = Inst->opcode();
-      if (Op == G4_opcode::G4_return || Op == G4_opcode::G4_label)
-        continue;
-      if (Inst->isOptBarrier()) {
-        // Do not try to build def-use accross an optimization barrier,
-        // and this effectively disables optimizations across it.
-        LLI.populateGlobals(globalOpndHT);
+void FlowGraph::localDataFlowAnalysis(G4_BB *BB) {
+  LocalLivenessInfo LLI(!BB->isAllLaneActive());
+  for (auto I = BB->rbegin(), E = BB->rend(); I != E; ++I) {
+    G4_INST *Inst = *I;
+    G4_opcode Op = Inst->opcode();
+    if (Op == G4_opcode::G4_return || Op == G4_opcode::G4_label)
+      continue;
+    if (Inst->isOptBarrier()) {
+      // Do not try to build def-use accross an optimization barrier,
+      // and this effectively disables optimizations across it.
+      LLI.populateGlobals(globalOpndHT);
 
-        // A barrier does not kill, but may introduce uses.
-        processReadOpnds(BB, Inst, LLI);
-        continue;
-      }
-      processWriteOpnds(BB, Inst, LLI);
+      // A barrier does not kill, but may introduce uses.
       processReadOpnds(BB, Inst, LLI);
+      continue;
     }
+    processWriteOpnds(BB, Inst, LLI);
+    processReadOpnds(BB, Inst, LLI);
+  }
 
-    // All left over live nodes are global.
-    LLI.populateGlobals(globalOpndHT);
-
-    // Sort use lists according to their local ids.
-    // This matches the use list order produced by forward
-    // reaching definition based analysis. It is better for
-    // optimizations not to rely on this order.
-    BB->resetLocalIds();
-    for (auto Inst : *BB) {
-      if (Inst->use_size() > 1) {
-        using Ty = std::pair<vISA::G4_INST *, Gen4_Operand_Number>;
-        auto Cmp = [](const Ty &lhs, const Ty &rhs) -> bool {
-          int lhsID = lhs.first->getLocalId();
-          int rhsID = rhs.first->getLocalId();
-          if (lhsID < rhsID)
-            return true;
-          else if (lhsID > rhsID)
-            return false;
-          return lhs.second < rhs.second;
-        };
-        Inst->sortUses(Cmp);
-      }
+  // All left over live nodes are global.
+  LLI.populateGlobals(globalOpndHT);
+
+  // Sort use lists according to their local ids.
+  // This matches the use list order produced by forward
+  // reaching definition based analysis. It is better for
+  // optimizations not to rely on this order.
+  BB->resetLocalIds();
+  for (auto Inst : *BB) {
+    if (Inst->use_size() > 1) {
+      using Ty = std::pair<vISA::G4_INST *, Gen4_Operand_Number>;
+      auto Cmp = [](const Ty &lhs, const Ty &rhs) -> bool {
+        int lhsID = lhs.first->getLocalId();
+        int rhsID = rhs.first->getLocalId();
+        if (lhsID < rhsID)
+          return true;
+        else if (lhsID > rhsID)
+          return false;
+        return lhs.second < rhs.second;
+      };
+      Inst->sortUses(Cmp);
     }
   }
 }
 
+void FlowGraph::localDataFlowAnalysis() {
+  for (auto BB : BBs)
+    localDataFlowAnalysis(BB);
+}
+
 // Reset existing def-use
 void FlowGraph::resetLocalDataFlowData() {
   globalOpndHT.clearHashTable();
@@ -543,6 +546,19 @@ void FlowGraph::resetLocalDataFlowData() {
   }
 }
 
+// Rebuild the def-use of a single BB after a pass has rewritten it, leaving
+// the rest of the kernel's def-use alone. The edges are dropped from both
+// ends, so that any edge to an instruction that has since moved to another
+// BB does not dangle. Entries of the global operand table computed from the
+// old code are kept; they can only make isOpndGlobal() more conservative.
+void FlowGraph::rebuildLocalDataFlow(G4_BB *bb) {
+  for (auto inst : *bb) {
+    inst->removeAllDefs();
+    inst->removeAllUses();
+  }
+  localDataFlowAnalysis(bb);
+}
+
 void DefEscapeBBAnalysis::analyzeBB(G4_BB *bb) {
   // active defines in this BB, organized by root declare
   invalidateBB(bb);
@@ -484,7 +484,8 @@ class BB_Scheduler {
 public:
   BB_Scheduler(G4_Kernel &kernel, preDDD &ddd, RegisterPressure &rp,
                SchedConfig config, const LatencyTable &LT)
-      : kernel(kernel), ddd(ddd), rp(rp), config(config), LT(LT) {}
+      : kernel(kernel), ddd(ddd), rp(rp),
+        OrigInstList(kernel.fg.instListAlloc), config(config), LT(LT) {}
   ~BB_Scheduler() {
     schedule.clear();
     OrigInstList.clear();
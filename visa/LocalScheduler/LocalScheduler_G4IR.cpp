@@ -11,8 +11,11 @@ SPDX-License-Identifier: MIT
 #include "../PointsToAnalysis.h"
 #include "../Timer.h"
 #include "Dependencies_G4IR.h"
+#include "../Parallel.h"
 #include "visa_wa.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <functional>
 #include <queue>
@@ -39,11 +42,13 @@ void LocalScheduler::localScheduling() {
   PointsToAnalysis p(fg.getKernel()->Declares, fg.size());
   p.doPointsToAnalysis(fg);
 
-  uint32_t totalCycles = 0;
   uint32_t scheduleStartBBId =
       options->getuInt32Option(vISA_LocalSchedulingStartBB);
   uint32_t shceduleEndBBId =
       options->getuInt32Option(vISA_LocalSchedulingEndBB);
+  // BBs that go through G4_BB_Schedule as a whole are only collected here,
+  // with the index of their bbInfo entry, and scheduled below.
+  std::vector<std::pair<G4_BB *, size_t>> toSchedule;
   for (G4_BB *bb : fg) {
     if (bb->getId() < scheduleStartBBId || bb->getId() > shceduleEndBBId)
       continue;
@@ -57,7 +62,6 @@ void LocalScheduler::localScheduling() {
 
       bbInfo.push_back({(int)bb->getId(), sequentialCycles, 0,
           (unsigned char)bb->getNestLevel()});
-      totalCycles += sequentialCycles;
       continue;
     }
 
@@ -68,6 +72,8 @@ void LocalScheduler::localScheduling() {
       // traversing DAG in list scheduler, stack overflow occurs.
       // So artificially breakup inst list here to reduce size
       // of scheduler problem size.
+      // This creates new BBs in the flow graph, so it is always done on
+      // this thread.
       unsigned int count = 0;
       unsigned int sequentialCycles = 0;
       unsigned int sendStallCycles = 0;
@@ -94,20 +100,41 @@ void LocalScheduler::localScheduling() {
       }
       bbInfo.push_back({(int)bb->getId(), sequentialCycles, sendStallCycles,
           (unsigned char)bb->getNestLevel()});
-      totalCycles += sequentialCycles;
     } else {
-      G4_BB_Schedule schedule(fg.getKernel(), bb, *LT, p);
-      bbInfo.push_back({(int)bb->getId(), schedule.sequentialCycle,
-          schedule.sendStallCycle, (unsigned char)bb->getNestLevel()});
-      totalCycles += schedule.sequentialCycle;
+      toSchedule.emplace_back(bb, bbInfo.size());
+      bbInfo.push_back({(int)bb->getId(), 0, 0,
+          (unsigned char)bb->getNestLevel()});
     }
   }
 
+  // Scheduling a BB only reads state shared with the other BBs (options,
+  // latencies, points-to), reorders the BB's own instruction list and
+  // allocates its dependence graph from its own DDD arena, so BBs can be
+  // scheduled concurrently with the same result as in order.
+  auto scheduleBB = [&](const std::pair<G4_BB *, size_t> &item) {
+    G4_BB_Schedule schedule(fg.getKernel(), item.first, *LT, p);
+    bbInfo[item.second].staticCycle = schedule.sequentialCycle;
+    bbInfo[item.second].sendStallCycle = schedule.sendStallCycle;
+  };
+  vISA::parallelFor(options->getuInt32Option(vISA_LocalSchedulingThreads),
+                    toSchedule.size(),
+                    [&](size_t i) { scheduleBB(toSchedule[i]); });
+
+  uint32_t totalCycles = 0;
+  for (auto &bbStat : bbInfo)
+    totalCycles += bbStat.staticCycle;
+
   // Sum up the cycles for each BB.
   unsigned sendStallCycle = 0;
   unsigned staticCycle = 0;
   unsigned loopNestedStallCycle = 0;
   unsigned loopNestedCycle = 0;
+  // The per work-item estimate weights loops by a trip count that can be
+  // tuned, as vISA does not know the real ones.
+  double weightedStallCycle = 0;
+  double weightedCycle = 0;
+  double loopTripCount =
+      std::max(1u, options->getuInt32Option(vISA_LoopTripCountEstimate));
   for (auto &bbStat : bbInfo) {
     sendStallCycle += bbStat.sendStallCycle;
     staticCycle += bbStat.staticCycle;
@@ -115,6 +142,9 @@ void LocalScheduler::localScheduling() {
     auto nestingfactor = (bbStat.loopNestLevel * 4);
     loopNestedStallCycle += (bbStat.sendStallCycle << nestingfactor);
     loopNestedCycle += (bbStat.staticCycle << nestingfactor);
+    double tripCount = std::pow(loopTripCount, (double)bbStat.loopNestLevel);
+    weightedStallCycle += bbStat.sendStallCycle * tripCount;
+    weightedCycle += bbStat.staticCycle * tripCount;
   }
 
   FINALIZER_INFO *jitInfo = fg.builder->getJitInfo();
@@ -123,6 +153,27 @@ void LocalScheduler::localScheduling() {
   jitInfo->stats.loopNestedStallCycle = loopNestedStallCycle;
   jitInfo->stats.loopNestedCycle = loopNestedCycle;
   jitInfo->stats.numCycles = totalCycles;
+  jitInfo->stats.cyclesPerWorkItem = (float)estimateCyclesPerWorkItem(
+      weightedCycle, weightedStallCycle, fg.getKernel()->getSimdSize(),
+      fg.getKernel()->getNumThreads());
+}
+
+// Predicted EU cycles spent per work-item. A thread takes `cycles` to run
+// through the kernel, of which `stallCycles` are spent waiting on sends. The
+// EU interleaves its `numThreads` threads to hide those stalls, so a thread
+// costs at least its issue cycles, and at least its share of the total
+// latency once there are too few threads to cover it. The thread's cost is
+// then spread over its `simdSize` work-items.
+double LocalScheduler::estimateCyclesPerWorkItem(double cycles,
+                                                 double stallCycles,
+                                                 unsigned simdSize,
+                                                 unsigned numThreads) {
+  if (simdSize == 0)
+    return 0;
+  double issueCycles = cycles - std::min(cycles, stallCycles);
+  double threadCycles =
+      std::max(issueCycles, cycles / std::max(numThreads, 1u));
+  return threadCycles / simdSize;
 }
 
 void G4_BB_Schedule::dumpSchedule(G4_BB *bb) {
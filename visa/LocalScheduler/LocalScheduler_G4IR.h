@@ -339,6 +339,10 @@ class LocalScheduler {
 public:
   LocalScheduler(FlowGraph &flowgraph) : fg(flowgraph) {}
   void localScheduling();
+
+  static double estimateCyclesPerWorkItem(double cycles, double stallCycles,
+                                          unsigned simdSize,
+                                          unsigned numThreads);
 };
 
 class preRA_Scheduler {
@@ -1586,7 +1586,7 @@ void SWSB::SWSBGlobalTokenGenerator(PointsToAnalysis &p, LiveGRFBuckets &LB,
     }
   }
 
-  // Global analysis until no live in change
+  // Global analysis until no live out change
   SWSBGlobalScalarCFGReachAnalysis();
 
   // Add dependence according to analysis result
@@ -2640,64 +2640,95 @@ bool SWSB::globalTokenReachAnalysis(G4_BB *bb) {
     temp_live_in |= BBVector[predID]->liveOutTokenNodes;
   }
 
-  // Changed? Yes, get the new live in, other wise do nothing
-  if (temp_live_in != BBVector[bbID]->liveInTokenNodes) {
-    changed = true;
-    BBVector[bbID]->liveInTokenNodes = temp_live_in;
-  }
+  BBVector[bbID]->liveInTokenNodes = temp_live_in;
 
   // Calculate the live out according to the live in and killed tokens in
   // current BB
-  for (uint32_t token = 0; token < totalTokenNum; token++) {
-    if (BBVector[bbID]->killedTokens.isSet(token)) {
-      temp_live_in -= allTokenNodesMap[token].bitset;
-    }
-  }
+  temp_live_in -= BBVector[bbID]->killedTokenNodes;
 
   // Get the new live out,
   // FIXME: is it right? the live out is always assigned in increasing.
   // Original, we only have local live out.
   // should we separate the local live out vs total live out?
   // Not necessary, can live out, will always be live out.
-  BBVector[bbID]->liveOutTokenNodes |= temp_live_in;
+  BitSet live_out = BBVector[bbID]->liveOutTokenNodes;
+  live_out |= temp_live_in;
+  if (live_out != BBVector[bbID]->liveOutTokenNodes) {
+    changed = true;
+    BBVector[bbID]->liveOutTokenNodes = live_out;
+  }
 
   return changed;
 }
 
-void SWSB::SWSBGlobalTokenAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalTokenReachAnalysis(bb)) {
-        change = true;
-      }
+//
+// Iterates a global analysis to its fixed point with a worklist. transfer(bb)
+// recomputes the live in and live out of bb and returns true if the live out
+// grew, in which case the successors of bb in the scalar and/or SIMD CFG are
+// visited again. Live outs only ever grow and transfer() is monotonic, so
+// this reaches the same fixed point as sweeping over all the BBs until
+// nothing changes, while only revisiting the BBs whose inputs changed.
+//
+template <typename TransferFn>
+void SWSB::solveGlobalDataflow(TransferFn transfer, bool scalarSuccs,
+                               bool simdSuccs) {
+  TIME_SCOPE(SWSB_GLOBAL_DATAFLOW);
+  std::queue<G4_BB *> worklist;
+  std::vector<bool> queued(BBVector.size(), false);
+  for (G4_BB *bb : fg) {
+    worklist.push(bb);
+    queued[bb->getId()] = true;
+  }
+  auto enqueue = [&](G4_BB *bb) {
+    if (!queued[bb->getId()]) {
+      queued[bb->getId()] = true;
+      worklist.push(bb);
+    }
+  };
+
+  while (!worklist.empty()) {
+    G4_BB *bb = worklist.front();
+    worklist.pop();
+    queued[bb->getId()] = false;
+    if (!transfer(bb))
+      continue;
+    if (scalarSuccs) {
+      for (G4_BB *succ : bb->Succs)
+        enqueue(succ);
+    }
+    if (simdSuccs) {
+      for (G4_BB_SB *succ : BBVector[bb->getId()]->Succs)
+        enqueue(succ->getBB());
     }
   }
 }
 
-void SWSB::SWSBGlobalScalarCFGReachAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalDependenceDefReachAnalysis(bb)) {
-        change = true;
+void SWSB::SWSBGlobalTokenAnalysis() {
+  // The tokens of the sends don't change during the analysis, so the sends
+  // killed by each BB can be gathered once instead of on every visit.
+  for (G4_BB_SB *sb_bb : BBVector) {
+    sb_bb->killedTokenNodes = BitSet(unsigned(SBSendNodes.size()), false);
+    for (uint32_t token = 0; token < totalTokenNum; token++) {
+      if (sb_bb->killedTokens.isSet(token)) {
+        sb_bb->killedTokenNodes |= allTokenNodesMap[token].bitset;
       }
     }
   }
+
+  solveGlobalDataflow(
+      [this](G4_BB *bb) { return globalTokenReachAnalysis(bb); }, true, true);
+}
+
+void SWSB::SWSBGlobalScalarCFGReachAnalysis() {
+  solveGlobalDataflow(
+      [this](G4_BB *bb) { return globalDependenceDefReachAnalysis(bb); }, true,
+      false);
 }
 
 void SWSB::SWSBGlobalSIMDCFGReachAnalysis() {
-  bool change = true;
-  while (change) {
-    change = false;
-    for (G4_BB *bb : fg) {
-      if (globalDependenceUseReachAnalysis(bb)) {
-        change = true;
-      }
-    }
-  }
+  solveGlobalDataflow(
+      [this](G4_BB *bb) { return globalDependenceUseReachAnalysis(bb); },
+      false, true);
 }
 
 void SWSB::setTopTokenIndex() {
@@ -4701,7 +4732,6 @@ void SWSB::buildLiveIntervals() {
 // live_out(BBi) += live_in(BBi) - may_kill(BBi)
 //
 bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
-  bool changed = false;
   unsigned bbID = bb->getId();
 
   if (bb->Preds.empty()) {
@@ -4717,7 +4747,6 @@ bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
   }
 
   if (temp_live_in != BBVector[bbID]->send_live_in) {
-    changed = true;
     BBVector[bbID]->send_live_in = temp_live_in;
   }
 
@@ -4736,9 +4765,11 @@ bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
   temp_live_in -= BBVector[bbID]->send_may_kill;
   temp_live_in.src = temp_live_in.src - BBVector[bbID]->send_may_kill.dst;
 
-  BBVector[bbID]->send_live_out |= temp_live_in;
+  // The live out only ever grows, |= reports whether it did.
+  bool dstChanged = BBVector[bbID]->send_live_out.dst |= temp_live_in.dst;
+  bool srcChanged = BBVector[bbID]->send_live_out.src |= temp_live_in.src;
 
-  return changed;
+  return dstChanged || srcChanged;
 }
 
 //
@@ -4746,7 +4777,6 @@ bool SWSB::globalDependenceDefReachAnalysis(G4_BB *bb) {
 // live_out(BBi) += live_in(BBi) - may_kill(BBi)
 //
 bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
-  bool changed = false;
   unsigned bbID = bb->getId();
 
   if (bb->Preds.empty()) {
@@ -4764,7 +4794,6 @@ bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
   }
 
   if (temp_live_in != BBVector[bbID]->send_live_in) {
-    changed = true;
     BBVector[bbID]->send_live_in = temp_live_in;
   }
 
@@ -4773,9 +4802,11 @@ bool SWSB::globalDependenceUseReachAnalysis(G4_BB *bb) {
   temp_live_in.src = temp_live_in.src - BBVector[bbID]->send_may_kill.src;
   temp_live_in.dst = temp_live_in.dst - BBVector[bbID]->send_WAW_may_kill;
 
-  BBVector[bbID]->send_live_out |= temp_live_in;
+  // The live out only ever grows, |= reports whether it did.
+  bool dstChanged = BBVector[bbID]->send_live_out.dst |= temp_live_in.dst;
+  bool srcChanged = BBVector[bbID]->send_live_out.src |= temp_live_in.src;
 
-  return changed;
+  return dstChanged || srcChanged;
 }
 
 void SWSB::tokenEdgePrune(unsigned &prunedEdgeNum,
@@ -688,6 +688,9 @@ public:
   BitSet liveInTokenNodes;
   BitSet liveOutTokenNodes;
   BitSet killedTokens;
+  // The sends whose tokens are in killedTokens, for the global token
+  // analysis.
+  BitSet killedTokenNodes;
   std::vector<BitSet> tokeNodesMap;
   int first_DPASID = 0;
   int last_DPASID = 0;
@@ -1086,6 +1089,9 @@ class SWSB {
 
   void SWSBGlobalTokenAnalysis();
   bool globalTokenReachAnalysis(G4_BB *bb);
+  template <typename TransferFn>
+  void solveGlobalDataflow(TransferFn transfer, bool scalarSuccs,
+                           bool simdSuccs);
 
   // Dump
   void dumpDepInfo() const;
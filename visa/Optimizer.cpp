@@ -43,7 +43,7 @@ using namespace vISA;
 
 void Optimizer::LVN() {
   // Run a simple LVN pass that replaces redundant
-  // immediate loads in current BB. Also this pass
+  // immediate loads in each extended BB. Also this pass
   // does not optimize operations like a
   // conventional VN pass because those require
   // more compile time, and are presumably already
@@ -53,10 +53,10 @@ void Optimizer::LVN() {
   int numInstsRemoved = 0;
   PointsToAnalysis p(kernel.Declares, kernel.fg.getNumBB());
   p.doPointsToAnalysis(kernel.fg);
+  ::LVN lvn(fg, *fg.builder, p);
+  lvn.doLVN();
+  numInstsRemoved += lvn.getNumInstsRemoved();
   for (auto bb : kernel.fg) {
-    ::LVN lvn(fg, bb, *fg.builder, p);
-    lvn.doLVN();
-    numInstsRemoved += lvn.getNumInstsRemoved();
     numInstsRemoved += ::LVN::removeRedundantSamplerMovs(kernel, bb);
   }
 
@@ -220,7 +220,10 @@ void Optimizer::regAlloc() {
   //
   // assign registers
   //
+  size_t outerArenaPeak = ArenaChunkPool::beginPhase();
   int status = ::regAlloc(builder, builder.phyregpool, kernel);
+  builder.getJitInfo()->statsVerbose.arenaRAPeakBytes =
+      ArenaChunkPool::endPhase(outerArenaPeak);
   if (status == VISA_EARLY_EXIT) {
     EarlyExited = true;
   } else if (status != VISA_SUCCESS) {
@@ -791,11 +794,9 @@ void Optimizer::accSubPostSchedule() {
   if (builder.getOption(vISA_localizationForAccSub)) {
     HWConformity hwConf(builder, kernel);
     for (auto bb : kernel.fg) {
-      hwConf.localizeForAcc(bb);
+      if (hwConf.localizeForAcc(bb))
+        kernel.fg.rebuildLocalDataFlow(bb);
     }
-
-    kernel.fg.resetLocalDataFlowData();
-    kernel.fg.localDataFlowAnalysis();
   }
 
   AccSubPass accSub(builder, kernel);
@@ -814,11 +815,9 @@ void Optimizer::accSubBeforeRA() {
   if (builder.getOption(vISA_localizationForAccSub)) {
     HWConformity hwConf(builder, kernel);
     for (auto bb : kernel.fg) {
-      hwConf.localizeForAcc(bb);
+      if (hwConf.localizeForAcc(bb))
+        kernel.fg.rebuildLocalDataFlow(bb);
     }
-
-    kernel.fg.resetLocalDataFlowData();
-    kernel.fg.localDataFlowAnalysis();
   }
 
   AccSubPass accSub(builder, kernel);
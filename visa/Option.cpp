@@ -12,12 +12,14 @@ SPDX-License-Identifier: MIT
 #include "PlatformInfo.h"
 #include "Timer.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <string_view>
@@ -730,3 +732,11 @@ Options::Options() : m_vISAOptions(this) {
   initializeArgToOption();
   initialize_m_vISAOptions();
 }
+
+Options::Options(const Options &other)
+    : argToOption(other.argToOption), m_vISAOptions(other.m_vISAOptions, this),
+      target(other.target), stepping(other.stepping) {
+  std::copy(std::begin(other.vISAOptionsToStr),
+            std::end(other.vISAOptionsToStr), vISAOptionsToStr);
+  argString << other.argString.str();
+}
@@ -113,6 +113,9 @@ class Options {
 
 public:
   Options();
+  // Copies all the option values, for a kernel whose compilation must not
+  // change the options seen by the other kernels of its builder.
+  Options(const Options &other);
 
   const char *get_vISAOptionsToStr(vISAOptions opt) {
     return vISAOptionsToStr[opt];
@@ -332,6 +335,8 @@ private:
     }
     explicit VISAOptionsDB(Options *opt)
         : optionsMap(static_cast<int>(vISA_NUM_OPTIONS)), options(opt) {}
+    VISAOptionsDB(const VISAOptionsDB &other, Options *opt)
+        : options(opt), optionsMap(other.optionsMap) {}
 
     ~VISAOptionsDB() {}
   };
@@ -0,0 +1,69 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2024 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace vISA {
+// Runs 'work(i)' for each i in [0, numItems) on up to 'numThreads' threads,
+// the calling one included; with one thread (or none) the items are done in
+// order on the calling thread. Items are handed out one at a time so that a
+// few large ones don't leave the other threads idle. If a thread cannot be
+// started, the ones already running do its share.
+//
+// The first exception thrown by 'work' stops handing out items and is
+// rethrown on the calling thread once all threads are done.
+template <typename F>
+void parallelFor(size_t numThreads, size_t numItems, F work) {
+  if (numThreads > numItems)
+    numThreads = numItems;
+  if (numThreads <= 1) {
+    for (size_t i = 0; i < numItems; i++)
+      work(i);
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto worker = [&]() {
+    try {
+      for (size_t i = next++; i < numItems; i = next++)
+        work(i);
+    } catch (...) {
+      next = numItems;
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < numThreads; t++) {
+    try {
+      threads.emplace_back(worker);
+    } catch (const std::system_error &) {
+      break;
+    }
+  }
+  worker();
+  for (auto &t : threads)
+    t.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+} // namespace vISA
+
+#endif // _PARALLEL_H_
@@ -503,6 +503,10 @@ void LVN::replaceAllUses(G4_INST *defInst, bool negate, UseList &uses,
 
     unsigned int srcIndex = G4_INST::getSrcNum(use.second);
     useInst->setSrc(srcRgn, srcIndex);
+    if (lvnInst->getLocalId() < bbFirstLocalId) {
+      // lvnInst's dst now flows in from a dominating BB.
+      fg.globalOpndHT.addGlobalOpnd(srcRgn);
+    }
   }
 }
 
@@ -526,10 +530,10 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion *dst) {
       if (potentialRedef->inst && potentialRedef->inst->getDst() &&
           potentialRedef->inst->getDst()->getTopDcl() == dstTopDcl &&
           IS_VAR_REDEFINED(dst, potentialRedef->inst->getDst())) {
-        potentialRedef->active = false;
+        deactivate(potentialRedef);
 
         for (auto use : potentialRedef->uses) {
-          use->active = false;
+          deactivate(use);
         }
       } else {
         for (unsigned int i = 0, numSrc = potentialRedef->inst->getNumSrc();
@@ -537,10 +541,10 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion *dst) {
           if (potentialRedef->inst && potentialRedef->inst->getSrc(i) &&
               potentialRedef->inst->getSrc(i)->getTopDcl() == dstTopDcl &&
               IS_VAR_REDEFINED(dst, potentialRedef->inst->getSrc(i))) {
-            potentialRedef->active = false;
+            deactivate(potentialRedef);
 
             for (auto use : potentialRedef->uses) {
-              use->active = false;
+              deactivate(use);
             }
           }
         }
@@ -558,14 +562,13 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion *dst) {
     // ...
     // V10 = 0 <-- Current instruction - Invalidate inst1
     // V30 = r[A0] <-- inst1 != this inst
-    for (auto dcls : lvnTable) {
-      for (auto second = dcls.second.begin(); second != dcls.second.end();) {
-        auto lvnItems = (*second);
+    for (auto &dcls : lvnTable) {
+      for (auto lvnItems : dcls.second) {
         auto lvnItemsInst = lvnItems->inst;
 
         for (unsigned int i = 0, numSrc = lvnItemsInst->getNumSrc(); i < numSrc;
              i++) {
-          if (lvnItemsInst && lvnItemsInst->getSrc(i) &&
+          if (lvnItemsInst->getSrc(i) &&
               lvnItemsInst->getSrc(i)->isSrcRegRegion() &&
               lvnItemsInst->getSrc(i)->asSrcRegRegion()->isIndirect()) {
             if (p2a.isPresentInPointsTo(lvnItemsInst->getSrc(i)
@@ -573,21 +576,15 @@ void LVN::removeVirtualVarRedefs(G4_DstRegRegion *dst) {
                                             ->getTopDcl()
                                             ->getRegVar(),
                                         dst->getTopDcl()->getRegVar())) {
-              lvnItems->active = false;
-              second = dcls.second.erase(second);
+              deactivate(lvnItems);
 
               for (auto use : lvnItems->uses) {
-                use->active = false;
+                deactivate(use);
               }
-              continue;
+              break;
             }
           }
         }
-        if (second != dcls.second.end()) {
-          // Increment iterator only if dcls.second is not empty.
-          // Erase operation in earlier loop can result in this.
-          second++;
-        }
       }
     }
   }
@@ -616,16 +613,12 @@ bool LVN::sameGRFRef(G4_Declare *dcl1, G4_Declare *dcl2) {
 // LVN table that refer to same GRF.
 void LVN::removePhysicalVarRedefs(G4_DstRegRegion *dst) {
   G4_Declare *topdcl = dst->getTopDcl();
-  for (auto all : lvnTable) {
-    for (auto it = all.second.begin(); it != all.second.end();) {
-      auto item = (*it);
-      bool erase = false;
-
+  for (auto &all : lvnTable) {
+    for (auto item : all.second) {
       auto dstTopDcl = item->inst->getDst()->getTopDcl();
       if (dstTopDcl->getRegVar()->isGreg()) {
         if (sameGRFRef(topdcl, dstTopDcl)) {
-          item->active = false;
-          erase = true;
+          deactivate(item);
         }
       }
 
@@ -634,18 +627,10 @@ void LVN::removePhysicalVarRedefs(G4_DstRegRegion *dst) {
         if (srcTopDcl && srcTopDcl->getRegVar()->isGreg()) {
           // Check if both physical registers have an overlap
           if (sameGRFRef(topdcl, srcTopDcl)) {
-            item->active = false;
-            erase = true;
+            deactivate(item);
           }
         }
       }
-
-      if (erase) {
-        it = all.second.erase(it);
-        continue;
-      }
-
-      it++;
     }
   }
 }
@@ -685,7 +670,7 @@ void LVN::removeAliases(G4_INST *inst) {
       continue;
 
     for (auto d : it->second) {
-      d->active = false;
+      deactivate(d);
       VISA_DEBUG({
         std::cout << "Removing inst from LVN table for indirect dst conflict:";
         d->inst->emit(std::cerr);
@@ -792,22 +777,14 @@ LVNItemInfo *LVN::getOpndValue(G4_Operand *opnd, bool create) {
     }
   }
 
-  auto it = dclValueTable.find(topdcl);
-  if (it == dclValueTable.end()) {
-    if (!create) {
-      return nullptr;
-    }
-  }
-
-  if (it != dclValueTable.end()) {
-    for (auto &item : (*it).second) {
-      if (!item->active)
-        continue;
-
-      if (item->lb == lb && item->rb == rb && item->isScalar == isScalar &&
-          item->constHStride == isSingleStride && item->hstride == hs)
-        return item;
-    }
+  auto it = opndValueTable.find(
+      getOpndKey(topdcl, lb, rb, isScalar, isSingleStride, hs));
+  if (it != opndValueTable.end()) {
+    auto item = it->second;
+    if (item->active && item->lb == lb && item->rb == rb &&
+        item->isScalar == isScalar && item->constHStride == isSingleStride &&
+        item->hstride == hs)
+      return item;
   }
 
   if (create) {
@@ -874,10 +851,10 @@ void LVN::invalidateOldDstValue(G4_INST *inst) {
       continue;
 
     if (item->lb < rb && item->rb >= rb)
-      item->active = false;
+      deactivate(item);
 
     if (lb < item->rb && rb >= item->rb)
-      item->active = false;
+      deactivate(item);
   }
 }
 
@@ -1260,18 +1237,15 @@ bool LVN::isSameValue(Value &val1, Value &val2, bool negImmVal) {
 }
 
 LVNItemInfo *LVN::isValueInTable(Value &value, bool negate) {
-  int64_t hash = value.hash;
-
-  auto bucket = lvnTable.find(hash);
+  auto bucket = lvnTable.find(lvnKey(value.hash));
   if (bucket != lvnTable.end()) {
-    for (auto it = bucket->second.rbegin(); it != bucket->second.rend();) {
+    for (auto it = bucket->second.rbegin(); it != bucket->second.rend();
+         ++it) {
       auto lvnItem = (*it);
 
       if (lvnItem->active && isSameValue(value, lvnItem->value, negate)) {
         return lvnItem;
       }
-
-      it++;
     }
   }
 
@@ -1280,12 +1254,13 @@ LVNItemInfo *LVN::isValueInTable(Value &value, bool negate) {
 
 void LVN::addValueToTable(G4_INST *inst, Value &oldValue) {
   auto findLVNItemInfo = [this](G4_INST *inst, G4_Operand *opnd) {
-    auto it = dclValueTable.find(opnd->getTopDcl());
-    vISA_ASSERT(it != dclValueTable.end(), "Value not added");
+    // All the values of inst were created while processing it, so they are
+    // the ones just added from perInstValueCache.
     LVNItemInfo *lvnItem = nullptr;
-    for (auto item : (*it).second) {
-      if (item->inst == inst && opnd->getInst() == item->inst) {
-        return item;
+    for (auto &item : perInstValueCache) {
+      if (item.first == opnd->getTopDcl() && item.second->inst == inst &&
+          opnd->getInst() == item.second->inst) {
+        return item.second;
       }
     }
     vISA_ASSERT(lvnItem != nullptr, "Not expecting nullptr");
@@ -1293,15 +1268,10 @@ void LVN::addValueToTable(G4_INST *inst, Value &oldValue) {
     return lvnItem;
   };
 
-  auto insertInLvnTable = [this](int64_t key, LVNItemInfo *itemToIns) {
-    auto it = lvnTable.find(key);
-    if (it != lvnTable.end()) {
-      it->second.push_back(itemToIns);
-    } else {
-      std::list<vISA::LVNItemInfo *> second;
-      second.push_back(itemToIns);
-      lvnTable.insert(make_pair(key, second));
-    }
+  auto insertInLvnTable = [this](uint64_t key, LVNItemInfo *itemToIns) {
+    lvnTable[key].push_back(itemToIns);
+    undoLog.push_back(
+        {UndoEntry::ValueAdded, itemToIns, nullptr, nullptr, key});
     itemToIns->active = true;
   };
 
@@ -1328,6 +1298,8 @@ void LVN::addValueToTable(G4_INST *inst, Value &oldValue) {
               auto rb = l->rb;
               if (lb <= srcRb && rb >= srcLb) {
                 l->uses.push_back(lvnItem);
+                undoLog.push_back(
+                    {UndoEntry::UseAdded, l, nullptr, nullptr, 0});
               }
             }
           }
@@ -1337,13 +1309,19 @@ void LVN::addValueToTable(G4_INST *inst, Value &oldValue) {
   };
 
   for (auto &item : perInstValueCache) {
-    auto it = dclValueTable.find(item.first);
-    item.second->active = true;
-    dclValueTable[item.first].push_back(item.second);
+    LVNItemInfo *newItem = item.second;
+    newItem->active = true;
+    dclValueTable[item.first].push_back(newItem);
+    LVNItemInfo *&interned = opndValueTable[getOpndKey(
+        item.first, newItem->lb, newItem->rb, newItem->isScalar,
+        newItem->constHStride, newItem->hstride)];
+    undoLog.push_back(
+        {UndoEntry::ItemAdded, newItem, item.first, interned, 0});
+    interned = newItem;
   }
 
   auto lvnItem = findLVNItemInfo(inst, inst->getDst());
-  insertInLvnTable(oldValue.hash, lvnItem);
+  insertInLvnTable(lvnKey(oldValue.hash), lvnItem);
   attachUses(inst, lvnItem);
 
   vISA_ASSERT(lvnItem->inst == lvnItem->value.inst,
@@ -1361,42 +1339,29 @@ void LVN::addUse(G4_DstRegRegion *dst, G4_INST *use, unsigned int srcIndex) {
   }
 
   UseInfo useInst = {use, srcPos};
-  auto it = defUse.find(dst->getInst());
-
-  if (it == defUse.end()) {
-    UseList uses = {useInst};
-
-    defUse.insert(std::make_pair(dst->getInst(), uses));
-  } else {
-    (*it).second.push_back(useInst);
-  }
+  defUse[dst->getInst()].push_back(useInst);
 
   auto srcOpnd = use->getSrc(srcIndex);
-  auto itUD = useDef.find(srcOpnd);
-  if (itUD == useDef.end()) {
-    DefList defs = {dst->getInst()};
-    useDef.insert(std::make_pair(srcOpnd, defs));
-  } else {
-    (*itUD).second.push_back(dst->getInst());
-  }
+  useDef[srcOpnd].push_back(dst->getInst());
 }
 
 void LVN::removeAddrTaken(G4_AddrExp *opnd) {
   G4_Declare *opndTopDcl = opnd->getRegVar()->getDeclare()->getRootDeclare();
 
-  auto range_it = activeDefs.equal_range(opndTopDcl->getDeclId());
-  for (auto it = range_it.first; it != range_it.second;) {
-    auto prev_it = it;
-    (*prev_it).second.second->getInst()->removeAllUses();
-    it++;
-    activeDefs.erase(prev_it);
+  auto it = activeDefs.find(opndTopDcl->getDeclId());
+  if (it == activeDefs.end())
+    return;
+
+  for (auto &activeDef : it->second) {
+    activeDef.second->getInst()->removeAllUses();
   }
+  it->second.clear();
 }
 
 void LVN::populateDuTable(INST_LIST_ITER inst_it) {
   duTablePopulated = true;
   // Populate duTable from inst_it position
-  ActiveDefMMap activeDefs;
+  ActiveDefMap activeDefs;
   G4_INST *startInst = (*inst_it);
   G4_Operand *startInstDst = startInst->getDst();
   INST_LIST_ITER lastInstIt = bb->end();
@@ -1421,8 +1386,8 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
       if (opnd->isSrcRegRegion()) {
         G4_Declare *topdcl = opnd->getTopDcl();
         if (topdcl != NULL) {
-          auto range_it = activeDefs.equal_range(topdcl->getDeclId());
-          if (range_it.first == range_it.second) {
+          auto defs_it = activeDefs.find(topdcl->getDeclId());
+          if (defs_it == activeDefs.end() || defs_it->second.empty()) {
             // No match found so move on to next src opnd
             continue;
           }
@@ -1431,11 +1396,11 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
           unsigned int rb = opnd->getRightBound();
           unsigned int hs = getActualHStride(opnd->asSrcRegRegion());
 
-          auto start_it = range_it.second;
-          start_it--;
-          bool done = false;
-          for (auto it = start_it;;) {
-            G4_DstRegRegion *activeDst = (*it).second.second;
+          // Visit active defs bottom-up
+          for (auto it = defs_it->second.rbegin(),
+                    end = defs_it->second.rend();
+               it != end; ++it) {
+            G4_DstRegRegion *activeDst = (*it).second;
 
             unsigned int lb_dst = activeDst->getLeftBound();
             unsigned int rb_dst = activeDst->getRightBound();
@@ -1473,12 +1438,6 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
                 break;
               }
             }
-
-            if (done || it == range_it.first) {
-              // Last match reached
-              break;
-            }
-            it--;
           }
         }
       }
@@ -1489,31 +1448,24 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
       G4_Declare *curDstTopDcl = dst->getTopDcl();
       if (curDstTopDcl != NULL) {
         // Check if already an overlapping dst region is active
-        auto range_it = activeDefs.equal_range(curDstTopDcl->getDeclId());
-        for (auto it = range_it.first; it != range_it.second;) {
-          G4_DstRegRegion *activeDst = (*it).second.second;
-
+        auto &curDstDefs = activeDefs[curDstTopDcl->getDeclId()];
+        if (curInst->getPredicate() == NULL) {
           unsigned int lb = dst->getLeftBound();
           unsigned int rb = dst->getRightBound();
           unsigned int hs = dst->getHorzStride();
 
-          unsigned int lb_dst = activeDst->getLeftBound();
-          unsigned int rb_dst = activeDst->getRightBound();
-          unsigned int hs_dst = activeDst->getHorzStride();
-
-          if ((lb <= lb_dst && rb >= rb_dst) && hs == hs_dst) {
-            if (curInst->getPredicate() == NULL) {
-              // Current dst completely overlaps
-              // earlier def so retire earlier
-              // active def.
-              auto prev_it = it;
-              it++;
-              activeDefs.erase(prev_it);
-              continue;
-            }
-          }
-
-          it++;
+          // Current dst completely overlaps
+          // earlier def so retire earlier
+          // active def.
+          curDstDefs.erase(
+              std::remove_if(curDstDefs.begin(), curDstDefs.end(),
+                             [&](const ActiveDef &activeDef) {
+                               G4_DstRegRegion *activeDst = activeDef.second;
+                               return lb <= activeDst->getLeftBound() &&
+                                      rb >= activeDst->getRightBound() &&
+                                      hs == activeDst->getHorzStride();
+                             }),
+              curDstDefs.end());
         }
 
         bool addValueToDU = false;
@@ -1521,8 +1473,7 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
           addValueToDU = true;
         }
 
-        if (addValueToDU ||
-            (activeDefs.find(curDstTopDcl->getDeclId()) != activeDefs.end())) {
+        if (addValueToDU || !curDstDefs.empty()) {
           // mov (8) V10(0,0):d     r0.0:d - 1
           // shr (1) V10(0,1):d     0x1:d  - 2
           // send ... V10 ...              - 3
@@ -1536,7 +1487,7 @@ void LVN::populateDuTable(INST_LIST_ITER inst_it) {
           ActiveDef newActiveDef;
           newActiveDef.first = curDstTopDcl;
           newActiveDef.second = dst;
-          activeDefs.emplace(curDstTopDcl->getDeclId(), newActiveDef);
+          curDstDefs.push_back(newActiveDef);
         }
       }
     }
@@ -1549,13 +1500,147 @@ void LVN::invalidate() {
   // invalidate all values cached in value table
   for (auto &bucket : lvnTable) {
     for (auto &lvnItem : bucket.second) {
-      lvnItem->active = false;
+      deactivate(lvnItem);
+    }
+  }
+}
+
+void LVN::deactivate(LVNItemInfo *item) {
+  if (!item->active)
+    return;
+  item->active = false;
+  undoLog.push_back({UndoEntry::Deactivated, item, nullptr, nullptr, 0});
+}
+
+// Undo all the changes made to the tables after undoLog had mark entries.
+void LVN::rollback(size_t mark) {
+  while (undoLog.size() > mark) {
+    UndoEntry &entry = undoLog.back();
+    switch (entry.kind) {
+    case UndoEntry::Deactivated:
+      entry.item->active = true;
+      break;
+    case UndoEntry::ItemAdded: {
+      dclValueTable[entry.dcl].pop_back();
+      auto key = getOpndKey(entry.dcl, entry.item->lb, entry.item->rb,
+                            entry.item->isScalar, entry.item->constHStride,
+                            entry.item->hstride);
+      if (entry.prev)
+        opndValueTable[key] = entry.prev;
+      else
+        opndValueTable.erase(key);
+      break;
+    }
+    case UndoEntry::ValueAdded:
+      lvnTable[entry.key].pop_back();
+      break;
+    case UndoEntry::UseAdded:
+      entry.item->uses.pop_back();
+      break;
+    }
+    undoLog.pop_back();
+  }
+}
+
+void LVN::resetTables() {
+  lvnTable.clear();
+  dclValueTable.clear();
+  opndValueTable.clear();
+  undoLog.clear();
+  LVNAllocator.DestroyAll();
+}
+
+// Return true if the values available at the end of pred may be used in
+// succ, that is when succ is only entered from pred and does not run with
+// more lanes enabled than pred.
+bool LVN::canExtendInto(G4_BB *pred, G4_BB *succ) const {
+  if (succ == pred || succ->Preds.size() != 1 || succ->Preds.front() != pred)
+    return false;
+
+  // Callees may clobber anything.
+  if ((pred->getBBType() & (G4_BB_CALL_TYPE | G4_BB_RETURN_TYPE |
+                            G4_BB_EXIT_TYPE | G4_BB_FCALL_TYPE)) ||
+      (succ->getBBType() & (G4_BB_INIT_TYPE | G4_BB_RETURN_TYPE)) ||
+      pred->isEndWithCall() || pred->isEndWithFCall())
+    return false;
+
+  // Lanes come back at join/endif/while.
+  auto firstIt = succ->begin();
+  if (firstIt != succ->end() && (*firstIt)->isLabel())
+    ++firstIt;
+  if (firstIt != succ->getFirstInsertPos())
+    return false;
+
+  if ((pred->isDivergent() && !succ->isDivergent()) ||
+      (!pred->isAllLaneActive() && succ->isAllLaneActive()))
+    return false;
+
+  return true;
+}
+
+void LVN::processEBB(G4_BB *root, llvm::DenseSet<G4_BB *> &visited) {
+  resetTables();
+
+  struct PendingBB {
+    G4_BB *bb;
+    // undoLog size at the end of the dominating BB
+    size_t mark;
+    int firstLocalId;
+  };
+  std::vector<PendingBB> worklist = {{root, 0, 0}};
+  while (!worklist.empty()) {
+    PendingBB cur = worklist.back();
+    worklist.pop_back();
+    visited.insert(cur.bb);
+
+    rollback(cur.mark);
+    int nextLocalId = cur.firstLocalId + (int)cur.bb->size();
+    processBB(cur.bb, cur.firstLocalId);
+
+    if (!builder.getOption(vISA_LVNAcrossBBs))
+      continue;
+    // Visit the successors in layout order.
+    for (auto it = cur.bb->Succs.rbegin(), end = cur.bb->Succs.rend();
+         it != end; ++it) {
+      G4_BB *succ = *it;
+      if (!visited.count(succ) && canExtendInto(cur.bb, succ))
+        worklist.push_back({succ, undoLog.size(), nextLocalId});
     }
   }
 }
 
 void LVN::doLVN() {
-  bb->resetLocalIds();
+  llvm::DenseSet<G4_BB *> visited;
+  for (auto curBB : fg) {
+    if (visited.count(curBB))
+      continue;
+    // A BB extending its predecessor is processed along with it.
+    if (builder.getOption(vISA_LVNAcrossBBs) && curBB->Preds.size() == 1 &&
+        canExtendInto(curBB->Preds.front(), curBB))
+      continue;
+    processEBB(curBB, visited);
+  }
+
+  // BBs left are on cycles of single-predecessor BBs, which are not
+  // reachable from the entry.
+  for (auto curBB : fg) {
+    if (!visited.count(curBB))
+      processEBB(curBB, visited);
+  }
+}
+
+void LVN::processBB(G4_BB *curBB, int firstLocalId) {
+  bb = curBB;
+  bbFirstLocalId = firstLocalId;
+  int localId = firstLocalId;
+  for (auto inst : *bb) {
+    inst->setLocalId(localId++);
+  }
+  // Def-use is only tracked inside bb.
+  defUse.clear();
+  useDef.clear();
+  duTablePopulated = false;
+
   for (INST_LIST_ITER inst_it = bb->begin(), inst_end_it = bb->end();
        inst_it != inst_end_it; inst_it++) {
     G4_INST *inst = (*inst_it);
@@ -1567,6 +1652,22 @@ void LVN::doLVN() {
       continue;
     }
 
+    if (inst->isLifeTimeEnd()) {
+      // The data held by the dcl is dead past lifetime.end, so its values
+      // can no longer replace later computations.
+      G4_Declare *topdcl =
+          inst->getSrc(0) ? inst->getSrc(0)->getTopDcl() : nullptr;
+      auto it = topdcl ? dclValueTable.find(topdcl) : dclValueTable.end();
+      if (it != dclValueTable.end()) {
+        for (auto item : it->second) {
+          if (item->inst->getDst() &&
+              item->inst->getDst()->getTopDcl() == topdcl)
+            deactivate(item);
+        }
+      }
+      continue;
+    }
+
     if (inst->getDst() == NULL) {
       continue;
     }
@@ -15,6 +15,9 @@ SPDX-License-Identifier: MIT
 
 // clang-format off
 #include "common/LLVMWarningsPush.hpp"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Allocator.h"
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
@@ -73,42 +76,75 @@ public:
 }; // LVNItemInfo
 } // namespace vISA
 
-// LvnTable uses dcl id or immediate value as key. This key is mapped to
-// all operands with dcl id that have appeared so far in current BB. Or
-// in case of immediates the key maps to respective operands. Having
-// a map allows faster lookups and lesser number of comparisons than a
-// running list of all instructions seen so far.
-typedef std::unordered_map<int64_t, std::list<vISA::LVNItemInfo *>> LvnTable;
+// LvnTable maps a value hash to all the values with that hash that have
+// appeared so far on the current path through the extended basic block.
+// Having a map allows faster lookups and lesser number of comparisons than
+// a running list of all instructions seen so far. The hash is folded by
+// lvnKey() to stay clear of the keys DenseMap reserves; values sharing a
+// bucket are told apart by isSameValue() anyway.
+typedef llvm::DenseMap<uint64_t, llvm::SmallVector<vISA::LVNItemInfo *, 2>>
+    LvnTable;
 typedef struct UseInfo {
   vISA::G4_INST *first;
   Gen4_Operand_Number second;
 } UseInfo;
-typedef std::list<UseInfo> UseList;
-typedef std::list<vISA::G4_INST *> DefList;
-
-typedef struct DefUseInfo {
-  vISA::G4_INST *first;
-  UseList second;
-} DefUseInfo;
-typedef std::multimap<unsigned int, DefUseInfo> DefUseTable;
+typedef llvm::SmallVector<UseInfo, 4> UseList;
+typedef llvm::SmallVector<vISA::G4_INST *, 2> DefList;
 
 typedef struct ActiveDef {
   vISA::G4_Declare *first;
   vISA::G4_DstRegRegion *second;
 } ActiveDef;
-typedef std::multimap<unsigned int, ActiveDef> ActiveDefMMap;
+// Active defs of each dcl id, in program order.
+typedef llvm::DenseMap<unsigned int, llvm::SmallVector<ActiveDef, 2>>
+    ActiveDefMap;
 
 namespace vISA {
 class PointsToAnalysis;
+// Values are numbered over extended basic blocks: a BB whose only
+// predecessor is P is processed right after P with the tables P left
+// behind, so a value computed in P can replace a redundant one in the BB.
+// The EBB is walked depth-first, and every change made to the tables is
+// recorded in undoLog so that the tables can be rolled back to the end of
+// P before the next BB dominated by P is processed.
 class LVN {
 private:
-  std::map<G4_INST *, UseList> defUse;
-  std::map<G4_Operand *, DefList> useDef;
-  std::unordered_map<G4_Declare *, std::list<LVNItemInfo *>> dclValueTable;
-  G4_BB *bb;
+  // A change made to the value tables, undone when leaving the BB that made it.
+  struct UndoEntry {
+    enum Kind {
+      // item was deactivated.
+      Deactivated,
+      // item was appended to its dcl's dclValueTable entry and interned in
+      // opndValueTable, replacing prev.
+      ItemAdded,
+      // item was appended to the lvnTable bucket of key.
+      ValueAdded,
+      // a use was appended to item->uses.
+      UseAdded
+    } kind;
+    LVNItemInfo *item;
+    G4_Declare *dcl;
+    LVNItemInfo *prev;
+    uint64_t key;
+  };
+  typedef std::pair<G4_Declare *, uint64_t> OpndKey;
+
+  llvm::DenseMap<G4_INST *, UseList> defUse;
+  llvm::DenseMap<G4_Operand *, DefList> useDef;
+  llvm::DenseMap<G4_Declare *, llvm::SmallVector<LVNItemInfo *, 4>>
+      dclValueTable;
+  // Hash-consing of operand values: the latest value of each operand
+  // footprint, so that all the operands reading the same data share one
+  // LVNItemInfo.
+  llvm::DenseMap<OpndKey, LVNItemInfo *> opndValueTable;
+  std::vector<UndoEntry> undoLog;
+  G4_BB *bb = nullptr;
+  // Local id of the first inst of bb. Insts of the dominating BBs of the
+  // EBB have smaller ids.
+  int bbFirstLocalId = 0;
   FlowGraph &fg;
   LvnTable lvnTable;
-  ActiveDefMMap activeDefs;
+  ActiveDefMap activeDefs;
   LVNAlloc LVNAllocator;
   IR_Builder &builder;
   unsigned int numInstsRemoved;
@@ -118,6 +154,28 @@ private:
 
   static const int MaxLVNDistance = 250;
 
+  static uint64_t lvnKey(Value_Hash hash) {
+    return hash >= llvm::DenseMapInfo<uint64_t>::getTombstoneKey()
+               ? hash - 2
+               : hash;
+  }
+  static OpndKey getOpndKey(G4_Declare *topdcl, unsigned int lb,
+                            unsigned int rb, bool isScalar, bool constHStride,
+                            unsigned int hstride) {
+    uint64_t footprint = (uint64_t)lb | ((uint64_t)rb << 24) |
+                         ((uint64_t)(hstride & 0x3fff) << 48) |
+                         ((uint64_t)isScalar << 62) |
+                         ((uint64_t)constHStride << 63);
+    return std::make_pair(topdcl, footprint);
+  }
+
+  void processBB(G4_BB *curBB, int firstLocalId);
+  void processEBB(G4_BB *root, llvm::DenseSet<G4_BB *> &visited);
+  bool canExtendInto(G4_BB *pred, G4_BB *succ) const;
+  void deactivate(LVNItemInfo *item);
+  void rollback(size_t mark);
+  void resetTables();
+
   void populateDuTable(INST_LIST_ITER inst_it);
   void removeAddrTaken(G4_AddrExp *opnd);
   void addUse(G4_DstRegRegion *dst, G4_INST *use, unsigned int srcIndex);
@@ -158,16 +216,15 @@ private:
   void invalidate();
 
 public:
-  LVN(FlowGraph &flowGraph, G4_BB *curBB, IR_Builder &irBuilder,
-      PointsToAnalysis &p)
+  LVN(FlowGraph &flowGraph, IR_Builder &irBuilder, PointsToAnalysis &p)
       : fg(flowGraph), builder(irBuilder), p2a(p) {
-    bb = curBB;
     numInstsRemoved = 0;
     duTablePopulated = false;
   }
 
   ~LVN() = default;
 
+  // Run LVN over all the BBs of fg.
   void doLVN();
   unsigned int getNumInstsRemoved() { return numInstsRemoved; }
 
@@ -13,6 +13,8 @@ SPDX-License-Identifier: MIT
 #include <llvm/Support/Path.h>
 #include "common/LLVMWarningsPop.hpp"
 
+#include <climits>
+
 // All debugging tools related implementation should go here to keep actual
 // code clutter free.
 
@@ -367,6 +369,39 @@ void Interference::dumpInterference() const {
   }
 }
 
+// Report the storage used by the interference matrix. Comparing the output
+// of -ratrace runs with different -denseMatrixLimit/-tiledMatrixLimit values,
+// together with the Interference time of -timestats, shows how the backends
+// scale on a given kernel.
+void Interference::dumpMatrixFootprint() const {
+  std::cout << "\t--intf matrix: ";
+  if (useDenseMatrix()) {
+    std::cout << "dense, "
+              << (size_t)rowSize * maxId * sizeof(unsigned) << " bytes\n";
+  } else if (useTiledMatrix()) {
+    std::cout << "tiled, " << tiledMatrix.getNumTiles() << " tiles, "
+              << tiledMatrix.getMemoryUsage() << " bytes\n";
+  } else {
+    // Elements of a sparse bit vector are list nodes, count them from the
+    // bits they hold.
+    using Element = llvm::SparseBitVectorElement<2048>;
+    size_t numElements = 0;
+    for (unsigned i = 0; i < maxId; ++i) {
+      unsigned lastElt = UINT_MAX;
+      for (unsigned j : sparseMatrix[i]) {
+        if (j / Element::BITS_PER_ELEMENT != lastElt) {
+          lastElt = j / Element::BITS_PER_ELEMENT;
+          ++numElements;
+        }
+      }
+    }
+    std::cout << "sparse, " << numElements << " elements, "
+              << maxId * sizeof(llvm_SBitVector) +
+                     numElements * (sizeof(Element) + 2 * sizeof(void *))
+              << " bytes\n";
+  }
+}
+
 void Interference::dumpVarInterference() const {
 
   std::cout << "\n\n **** Var Interference Table ****\n";
@@ -14,10 +14,18 @@ SPDX-License-Identifier: MIT
 #include "PointsToAnalysis.h"
 #include "Timer.h"
 #include "VarSplit.h"
+#include "Parallel.h"
+
+// clang-format off
+#include "common/LLVMWarningsPush.hpp"
+#include "llvm/Support/MathExtras.h"
+#include "common/LLVMWarningsPop.hpp"
+// clang-format on
 
 #include <bitset>
 #include <climits>
 #include <cmath>
+#include <deque>
 #include <fstream>
 #include <optional>
 #include <vector>
@@ -468,6 +476,197 @@ bool LivenessAnalysis::doesVarNeedNoMaskForKill(const G4_Declare* dcl) const {
   return defWriteEnable.count(dcl) == 0 ? false : true;
 }
 
+namespace {
+//
+// Live sets of the context-free liveness, as seen by
+// LivenessAnalysis::solveContextFree(). This one works directly on the
+// sparse bit vectors of LivenessAnalysis.
+//
+class SparseLiveSets {
+  LivenessAnalysis &liveness;
+
+public:
+  SparseLiveSets(LivenessAnalysis &l) : liveness(l) {}
+
+  // use_out[bb] |= use_in[succ]
+  void mergeUseOut(unsigned bb, unsigned succ) {
+    liveness.use_out[bb] |= liveness.use_in[succ];
+  }
+  // use_in[bb] = use_gen[bb] + (use_out[bb] - use_kill[bb]), returns true if
+  // use_in[bb] changed.
+  bool updateUseIn(unsigned bb) {
+    llvm_SBitVector in = liveness.use_out[bb] - liveness.use_kill[bb];
+    in |= liveness.use_gen[bb];
+    if (in == liveness.use_in[bb])
+      return false;
+    liveness.use_in[bb] = std::move(in);
+    return true;
+  }
+  // def_in[bb] |= def_out[pred]
+  void mergeDefIn(unsigned bb, unsigned pred) {
+    liveness.def_in[bb] |= liveness.def_out[pred];
+  }
+  // def_out[bb] |= def_in[bb], returns true if def_out[bb] changed.
+  bool updateDefOut(unsigned bb) {
+    return liveness.def_out[bb] |= liveness.def_in[bb];
+  }
+};
+
+//
+// Same as SparseLiveSets, on one dense row of bits per BB. Rows are short
+// when there are few variables, and the word loops below vectorize, so this
+// is much faster than walking sparse bit vector elements.
+//
+class DenseLiveSets {
+  LivenessAnalysis &liveness;
+  const unsigned numWords;
+  std::vector<uint64_t> useGen, useKill, useIn, useOut, defIn, defOut;
+
+  uint64_t *row(std::vector<uint64_t> &sets, unsigned bb) {
+    return sets.data() + (size_t)bb * numWords;
+  }
+
+  void load(std::vector<uint64_t> &sets,
+            const std::vector<llvm_SBitVector> &from) {
+    sets.assign((size_t)from.size() * numWords, 0);
+    for (unsigned bb = 0, e = (unsigned)from.size(); bb != e; ++bb) {
+      uint64_t *r = row(sets, bb);
+      for (unsigned i : from[bb])
+        r[i / 64] |= 1ULL << (i % 64);
+    }
+  }
+
+  void store(std::vector<uint64_t> &sets, std::vector<llvm_SBitVector> &to,
+             unsigned bb) {
+    const uint64_t *r = row(sets, bb);
+    llvm_SBitVector &bv = to[bb];
+    bv.clear();
+    for (unsigned w = 0; w != numWords; ++w) {
+      for (uint64_t bits = r[w]; bits; bits &= bits - 1) {
+        unsigned i = w * 64 + (unsigned)llvm::countTrailingZeros(bits);
+        bv.set(i);
+      }
+    }
+  }
+
+  // dst |= src, returns true if dst changed.
+  bool unionWith(uint64_t *dst, const uint64_t *src) const {
+    uint64_t changed = 0;
+    for (unsigned w = 0; w != numWords; ++w) {
+      uint64_t merged = dst[w] | src[w];
+      changed |= merged ^ dst[w];
+      dst[w] = merged;
+    }
+    return changed != 0;
+  }
+
+public:
+  DenseLiveSets(LivenessAnalysis &l)
+      : liveness(l), numWords((l.getNumSelectedVar() + 63) / 64) {
+    load(useGen, l.use_gen);
+    load(useKill, l.use_kill);
+    load(useIn, l.use_in);
+    load(useOut, l.use_out);
+    load(defIn, l.def_in);
+    load(defOut, l.def_out);
+  }
+
+  void mergeUseOut(unsigned bb, unsigned succ) {
+    unionWith(row(useOut, bb), row(useIn, succ));
+  }
+  bool updateUseIn(unsigned bb) {
+    const uint64_t *gen = row(useGen, bb);
+    const uint64_t *kill = row(useKill, bb);
+    const uint64_t *out = row(useOut, bb);
+    uint64_t *in = row(useIn, bb);
+    uint64_t changed = 0;
+    for (unsigned w = 0; w != numWords; ++w) {
+      uint64_t newIn = gen[w] | (out[w] & ~kill[w]);
+      changed |= newIn ^ in[w];
+      in[w] = newIn;
+    }
+    return changed != 0;
+  }
+  void mergeDefIn(unsigned bb, unsigned pred) {
+    unionWith(row(defIn, bb), row(defOut, pred));
+  }
+  bool updateDefOut(unsigned bb) {
+    return unionWith(row(defOut, bb), row(defIn, bb));
+  }
+
+  // Copy the results back. Only the BBs taking part in the analysis can have
+  // changed.
+  void writeBack(const std::vector<G4_BB *> &blocks) {
+    for (G4_BB *bb : blocks) {
+      unsigned id = bb->getId();
+      store(useIn, liveness.use_in, id);
+      store(useOut, liveness.use_out, id);
+      store(defIn, liveness.def_in, id);
+      store(defOut, liveness.def_out, id);
+    }
+  }
+};
+
+#ifdef _DEBUG
+//
+// The round-robin solver that LivenessAnalysis::solveContextFree() replaced:
+// it sweeps over all BBs in PO until nothing changes. Debug builds solve a
+// copy of the sets with it and check that the worklist solver reaches the
+// same fixed point, for all four sets as IncrementalRA consumes them.
+//
+class RoundRobinLiveSets {
+  const LivenessAnalysis &liveness;
+  std::vector<llvm_SBitVector> use_in, use_out, def_in, def_out;
+
+public:
+  RoundRobinLiveSets(const LivenessAnalysis &l)
+      : liveness(l), use_in(l.use_in), use_out(l.use_out), def_in(l.def_in),
+        def_out(l.def_out) {}
+
+  void solve(const std::vector<G4_BB *> &PO) {
+    bool changed;
+    do {
+      changed = false;
+      for (G4_BB *bb : PO) {
+        unsigned id = bb->getId();
+        for (G4_BB *succ : bb->Succs)
+          use_out[id] |= use_in[succ->getId()];
+        llvm_SBitVector in = use_out[id] - liveness.use_kill[id];
+        in |= liveness.use_gen[id];
+        if (in != use_in[id]) {
+          use_in[id] = std::move(in);
+          changed = true;
+        }
+      }
+    } while (changed);
+
+    do {
+      changed = false;
+      for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I) {
+        unsigned id = (*I)->getId();
+        for (G4_BB *pred : (*I)->Preds)
+          def_in[id] |= def_out[pred->getId()];
+        if (def_out[id] |= def_in[id])
+          changed = true;
+      }
+    } while (changed);
+  }
+
+  void verify(const std::vector<G4_BB *> &PO) const {
+    for (G4_BB *bb : PO) {
+      unsigned id = bb->getId();
+      vISA_ASSERT(liveness.use_in[id] == use_in[id] &&
+                      liveness.use_out[id] == use_out[id],
+                  "worklist use analysis differs from round-robin");
+      vISA_ASSERT(liveness.def_in[id] == def_in[id] &&
+                      liveness.def_out[id] == def_out[id],
+                  "worklist def analysis differs from round-robin");
+    }
+  }
+};
+#endif
+} // namespace
+
 //
 // compute liveness of reg vars
 // Each reg var indicates a region within the register file. As such, the case
@@ -656,30 +855,32 @@ void LivenessAnalysis::computeLiveness() {
   std::vector<G4_BB *> PO;
   getPostOrder(fg.getEntryBB(), PO);
 
-  bool change;
-
-  //
-  // backward flow analysis to propagate uses (locate last uses)
-  //
-  do {
-    change = false;
-    for (auto I = PO.begin(), E = PO.end(); I != E; ++I)
-      change |= contextFreeUseAnalyze(*I, change);
-  } while (change);
-
   //
   // initialize entry block with payload input
   //
   def_in[fg.getEntryBB()->getId()] = inputDefs;
 
   //
-  // forward flow analysis to propagate defs (locate first defs)
+  // backward flow analysis to propagate uses (locate last uses), then forward
+  // flow analysis to propagate defs (locate first defs). Kernels with few
+  // variables are solved on dense bit vectors.
   //
-  do {
-    change = false;
-    for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
-      change |= contextFreeDefAnalyze(*I, change);
-  } while (change);
+#ifdef _DEBUG
+  RoundRobinLiveSets expected(*this);
+  expected.solve(PO);
+#endif
+  if (numVarId <= fg.builder->getOptions()->getuInt32Option(
+                      vISA_LivenessDenseMaxVars)) {
+    DenseLiveSets sets(*this);
+    solveContextFree(sets, PO);
+    sets.writeBack(PO);
+  } else {
+    SparseLiveSets sets(*this);
+    solveContextFree(sets, PO);
+  }
+#ifdef _DEBUG
+  expected.verify(PO);
+#endif
 
   //
   // dump vectors for debugging
@@ -879,6 +1080,61 @@ void LivenessAnalysis::defAnalysis(FuncInfo *subroutine) {
   } while (changed);
 }
 
+//
+// Run analyze on every subroutine in fg.sortedFuncTable, callers before their
+// callees if topDown and callees before their callers otherwise, and call
+// finish on each subroutine right after it is analyzed.
+// With -livenessThreads, subroutines are grouped in levels by their longest
+// call chain from the kernel (top-down) or to a leaf (bottom-up). Subroutines
+// of one level don't call each other and their BBs are disjoint, so they are
+// analyzed concurrently; finish, which may update other subroutines' sets, is
+// then called for each of them on this thread, in the serial order.
+//
+void LivenessAnalysis::forEachFuncLevel(
+    bool topDown, const std::function<void(FuncInfo *)> &analyze,
+    const std::function<void(FuncInfo *)> &finish) {
+  std::vector<FuncInfo *> order(fg.sortedFuncTable.begin(),
+                                fg.sortedFuncTable.end());
+  if (topDown)
+    std::reverse(order.begin(), order.end());
+
+  unsigned numThreads =
+      fg.builder->getOptions()->getuInt32Option(vISA_LivenessThreads);
+  if (numThreads <= 1 || order.size() <= 1) {
+    for (FuncInfo *subroutine : order) {
+      analyze(subroutine);
+      finish(subroutine);
+    }
+    return;
+  }
+
+  std::unordered_map<FuncInfo *, unsigned> levelOf;
+  std::vector<std::vector<FuncInfo *>> levels;
+  for (FuncInfo *subroutine : order) {
+    unsigned level = 0;
+    if (topDown) {
+      // all callers have been placed already and pushed their level down
+      level = levelOf[subroutine];
+      for (FuncInfo *callee : subroutine->getCallees())
+        levelOf[callee] = std::max(levelOf[callee], level + 1);
+    } else {
+      for (FuncInfo *callee : subroutine->getCallees())
+        level = std::max(level, levelOf[callee] + 1);
+      levelOf[subroutine] = level;
+    }
+    if (levels.size() <= level)
+      levels.resize(level + 1);
+    levels[level].push_back(subroutine);
+  }
+
+  for (auto &level : levels) {
+    vISA::parallelFor(numThreads, level.size(),
+                      [&](size_t i) { analyze(level[i]); });
+    for (FuncInfo *subroutine : level)
+      finish(subroutine);
+  }
+}
+
 void LivenessAnalysis::hierarchicalIPA(const llvm_SBitVector &kernelInput,
                                        const llvm_SBitVector &kernelOutput) {
 
@@ -925,16 +1181,9 @@ void LivenessAnalysis::hierarchicalIPA(const llvm_SBitVector &kernelInput,
   //  means it won't be killed in B if we do top-down)
   // But for now let's trade some loss of accuracy to save one more round of
   // fix-point
-  initKernelLiveOut();
-  for (auto FI = fg.sortedFuncTable.rbegin(), FE = fg.sortedFuncTable.rend();
-       FI != FE; ++FI) {
-    auto subroutine = *FI;
-    useAnalysis(subroutine);
-    if (subroutine != fg.kernelInfo) {
-      retVal[subroutine] = use_out[subroutine->getExitBB()->getId()];
-      retVal[subroutine] =
-          retVal[subroutine] - use_in[subroutine->getInitBB()->getId()];
-    }
+  // live-out of a callee's exit BB gets the live-in of the ret BB at each call
+  // site
+  auto propagateToCallees = [this](FuncInfo *subroutine) {
     for (auto &&bb : subroutine->getBBList()) {
       if (bb->getBBType() & G4_BB_CALL_TYPE) {
         G4_BB *retBB = bb->getPhysicalSucc();
@@ -944,7 +1193,19 @@ void LivenessAnalysis::hierarchicalIPA(const llvm_SBitVector &kernelInput,
         use_out[exitBB->getId()] |= use_in[retBB->getId()];
       }
     }
-  }
+  };
+
+  initKernelLiveOut();
+  forEachFuncLevel(
+      true, [this](FuncInfo *subroutine) { useAnalysis(subroutine); },
+      [&](FuncInfo *subroutine) {
+        if (subroutine != fg.kernelInfo) {
+          retVal[subroutine] = use_out[subroutine->getExitBB()->getId()];
+          retVal[subroutine] =
+              retVal[subroutine] - use_in[subroutine->getInitBB()->getId()];
+        }
+        propagateToCallees(subroutine);
+      });
 
   // bottom-up traversal to compute arg for each subroutine
   // arg[s] = live-in[s], except retval of its callees are excluded as by
@@ -953,34 +1214,30 @@ void LivenessAnalysis::hierarchicalIPA(const llvm_SBitVector &kernelInput,
   // this subroutine (and its callees)
   clearLiveSets();
   initKernelLiveOut();
-  for (auto subroutine : fg.sortedFuncTable) {
-    useAnalysisWithArgRetVal(subroutine, args, retVal);
-    if (subroutine != fg.kernelInfo) {
-      args[subroutine] = use_in[subroutine->getInitBB()->getId()];
-      args[subroutine] =
-          args[subroutine] - use_out[subroutine->getExitBB()->getId()];
-    }
-  }
+  forEachFuncLevel(
+      false,
+      [&](FuncInfo *subroutine) {
+        useAnalysisWithArgRetVal(subroutine, args, retVal);
+      },
+      [&](FuncInfo *subroutine) {
+        if (subroutine != fg.kernelInfo) {
+          args[subroutine] = use_in[subroutine->getInitBB()->getId()];
+          args[subroutine] =
+              args[subroutine] - use_out[subroutine->getExitBB()->getId()];
+        }
+      });
 
   // the real deal -- top-down traversal taking arg/retval/live-through all into
   // consideration again top-down traversal is needed to compute the live-out of
   // each subroutine.
   clearLiveSets();
   initKernelLiveOut();
-  for (auto FI = fg.sortedFuncTable.rbegin(), FE = fg.sortedFuncTable.rend();
-       FI != FE; ++FI) {
-    auto subroutine = *FI;
-    useAnalysisWithArgRetVal(subroutine, args, retVal);
-    for (auto &&bb : subroutine->getBBList()) {
-      if (bb->getBBType() & G4_BB_CALL_TYPE) {
-        G4_BB *retBB = bb->getPhysicalSucc();
-        G4_BB *exitBB = bb->getCalleeInfo()->getExitBB();
-        vISA_ASSERT((exitBB->getBBType() & G4_BB_EXIT_TYPE),
-                    "should be a subroutine's exit BB");
-        use_out[exitBB->getId()] |= use_in[retBB->getId()];
-      }
-    }
-  }
+  forEachFuncLevel(
+      true,
+      [&](FuncInfo *subroutine) {
+        useAnalysisWithArgRetVal(subroutine, args, retVal);
+      },
+      propagateToCallees);
 
   maydefAnalysis(); // must be done before defAnalysis!
 
@@ -993,9 +1250,9 @@ void LivenessAnalysis::hierarchicalIPA(const llvm_SBitVector &kernelInput,
   //  -- At each call site:
   //       add def_out[call-BB] to all of callee's BBs
   def_in[fg.getEntryBB()->getId()] = kernelInput;
-  for (auto subroutine : fg.sortedFuncTable) {
-    defAnalysis(subroutine);
-  }
+  forEachFuncLevel(
+      false, [this](FuncInfo *subroutine) { defAnalysis(subroutine); },
+      [](FuncInfo *) {});
 
   // FIXME: I assume we consider all caller's defs to be callee's defs too?
   for (auto FI = fg.sortedFuncTable.rbegin(), FE = fg.sortedFuncTable.rend();
@@ -1571,70 +1828,67 @@ void LivenessAnalysis::computeGenKillandPseudoKill(
   use_in = use_gen;
 }
 
+
 //
-// use_out = use_in(s1) + use_in(s2) + ... where s1 s2 ... are the successors of
-// bb use_in  = use_gen + (use_out - use_kill)
+// Worklist solver of the context-free liveness over the BBs in PO (the ones
+// reachable from the entry, in post order):
+//   use_out = use_in(s1) + use_in(s2) + ...   for successors s1 s2 ...
+//   use_in  = use_gen + (use_out - use_kill)
+//   def_in  = def_out(p1) + def_out(p2) + ... for predecessors p1 p2 ...
+//   def_out |= def_in
+// A BB is revisited only when the sets it depends on changed. Both problems
+// are monotone, so this reaches the same fixed point as iterating over all
+// BBs until nothing changes.
 //
-bool LivenessAnalysis::contextFreeUseAnalyze(G4_BB *bb, bool isChanged) {
-  bool changed;
+template <typename LiveSets>
+void LivenessAnalysis::solveContextFree(LiveSets &sets,
+                                        const std::vector<G4_BB *> &PO) {
+  std::vector<bool> reachable(numBBId, false);
+  for (G4_BB *bb : PO)
+    reachable[bb->getId()] = true;
+
+  std::vector<bool> queued(numBBId, false);
+  std::deque<G4_BB *> worklist;
+  auto enqueue = [&](G4_BB *bb) {
+    unsigned id = bb->getId();
+    if (reachable[id] && !queued[id]) {
+      queued[id] = true;
+      worklist.push_back(bb);
+    }
+  };
 
-  unsigned bbid = bb->getId();
+  for (G4_BB *bb : PO)
+    enqueue(bb);
+  while (!worklist.empty()) {
+    G4_BB *bb = worklist.front();
+    worklist.pop_front();
+    unsigned id = bb->getId();
+    queued[id] = false;
 
-  if (bb->Succs.empty()) // exit block
-  {
-    changed = false;
-  } else if (isChanged) {
-    // no need to update changed. This saves a memcpy
-    for (auto succBB : bb->Succs) {
-      use_out[bbid] |= use_in[succBB->getId()];
-    }
-    changed = true;
-  } else {
-    llvm_SBitVector old = use_out[bbid];
-    for (auto succBB : bb->Succs) {
-      use_out[bbid] |= use_in[succBB->getId()];
+    // use_out of exit blocks is given (output arguments)
+    for (G4_BB *succ : bb->Succs)
+      sets.mergeUseOut(id, succ->getId());
+    if (sets.updateUseIn(id)) {
+      for (G4_BB *pred : bb->Preds)
+        enqueue(pred);
     }
-
-    changed = (old != use_out[bbid]);
   }
 
-  //
-  // in = gen + (out - kill)
-  //
-  use_in[bbid] = use_out[bbid];
-  use_in[bbid] = use_in[bbid] - use_kill[bbid];
-  use_in[bbid] |= use_gen[bbid];
-
-  return changed;
-}
-
-//
-// def_in = def_out(p1) + def_out(p2) + ... where p1 p2 ... are the predecessors
-// of bb def_out |= def_in
-//
-bool LivenessAnalysis::contextFreeDefAnalyze(G4_BB *bb, bool isChanged) {
-  bool changed = false;
-  unsigned bbid = bb->getId();
+  for (auto I = PO.rbegin(), E = PO.rend(); I != E; ++I)
+    enqueue(*I);
+  while (!worklist.empty()) {
+    G4_BB *bb = worklist.front();
+    worklist.pop_front();
+    unsigned id = bb->getId();
+    queued[id] = false;
 
-  if (bb->Preds.empty()) {
-    changed = false;
-  } else if (isChanged) {
-    // no need to update changed. This saves a memcpy
-    for (auto predBB : bb->Preds) {
-      def_in[bbid] |= def_out[predBB->getId()];
+    for (G4_BB *pred : bb->Preds)
+      sets.mergeDefIn(id, pred->getId());
+    if (sets.updateDefOut(id)) {
+      for (G4_BB *succ : bb->Succs)
+        enqueue(succ);
     }
-    changed = true;
-  } else {
-    llvm_SBitVector old = def_in[bbid];
-    for (auto predBB : bb->Preds) {
-      def_in[bbid] |= def_out[predBB->getId()];
-    }
-    changed = (old != def_in[bbid]);
   }
-
-  def_out[bb->getId()] |= def_in[bb->getId()];
-
-  return changed;
 }
 
 void LivenessAnalysis::dump_bb_vector(char *vname, std::vector<BitSet> &vec) {
@@ -19,6 +19,8 @@ SPDX-License-Identifier: MIT
 #include "common/LLVMWarningsPop.hpp"
 // clang-format on
 
+#include <functional>
+
 
 namespace vISA {
 
@@ -73,8 +75,11 @@ class LivenessAnalysis {
                                    llvm_SBitVector &use_in, llvm_SBitVector &use_gen,
                                    llvm_SBitVector &use_kill) const;
 
-  bool contextFreeUseAnalyze(G4_BB *bb, bool isChanged);
-  bool contextFreeDefAnalyze(G4_BB *bb, bool isChanged);
+  template <typename LiveSets>
+  void solveContextFree(LiveSets &sets, const std::vector<G4_BB *> &PO);
+  void forEachFuncLevel(bool topDown,
+                        const std::function<void(FuncInfo *)> &analyze,
+                        const std::function<void(FuncInfo *)> &finish);
 
   bool livenessCandidate(const G4_Declare *decl, bool verifyRA) const;
 
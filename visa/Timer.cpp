@@ -10,8 +10,11 @@ SPDX-License-Identifier: MIT
 #include "Assertions.h"
 #include "Option.h"
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 #ifdef _WIN32
 #include "Windows.h"
@@ -98,38 +101,86 @@ bool QueryPerformanceCounter(LARGE_INTEGER *lpPerformanceCount) {
 
 namespace vISA {
 
+// Kernels may be compiled on several threads at once, so the totals are
+// atomic and the start of a running timer is kept per thread.
 struct Timer {
-  double time;
+  std::atomic<LONGLONG> ticks;
+  std::atomic<unsigned int> hits;
+};
+
+struct RunningTimer {
   LONGLONG currentStart;
-  const char *name;
-  LONGLONG ticks;
   bool started;
-  unsigned int hits;
 };
 
 } // namespace vISA
 
 static vISA::Timer timers[static_cast<int>(TimerID::NUM_TIMERS)];
-static LARGE_INTEGER proc_freq;
-static int numTimers = static_cast<int>(TimerID::NUM_TIMERS);
+static thread_local vISA::RunningTimer
+    runningTimers[static_cast<int>(TimerID::NUM_TIMERS)];
+static const int numTimers = static_cast<int>(TimerID::NUM_TIMERS);
+
+static LONGLONG getProcFreq() {
+  static const LONGLONG freq = []() {
+    LARGE_INTEGER f;
+    f.QuadPart = 1;
+#ifdef MEASURE_COMPILATION_TIME
+    QueryPerformanceFrequency(&f);
+#endif
+    return f.QuadPart;
+  }();
+  return freq;
+}
+
+static double getTimerTime(unsigned int idx) {
+  return timers[idx].ticks.load(std::memory_order_relaxed) /
+         (double)getProcFreq();
+}
+
+// Optional sink for the individual start/stop spans of the timers, set by a
+// host compiler that traces the whole compilation. Timestamps are in
+// microseconds of std::chrono::steady_clock. Like the timers themselves, it
+// is only called in builds with MEASURE_COMPILATION_TIME.
+typedef void (*TimerEventCallback)(unsigned int idx, uint64_t startUS,
+                                   uint64_t endUS);
+static std::atomic<TimerEventCallback> timerEventCallback{nullptr};
+static thread_local uint64_t
+    timerEventStart[static_cast<int>(TimerID::NUM_TIMERS)];
+
+static uint64_t timerEventNow() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
 
 void initTimer() {
 
 #ifdef MEASURE_COMPILATION_TIME
-  numTimers = 0;
   for (int i = 0; i < static_cast<int>(TimerID::NUM_TIMERS); i++) {
-    timers[i].time = 0;
-    timers[i].currentStart = 0;
-    timers[i].name = NULL;
-    timers[i].ticks = 0;
-    timers[i].started = false;
-    timers[i].hits = 0;
-    createNewTimer(timerNames[i]);
+    timers[i].ticks.store(0, std::memory_order_relaxed);
+    timers[i].hits.store(0, std::memory_order_relaxed);
+    runningTimers[i].currentStart = 0;
+    runningTimers[i].started = false;
   }
-  QueryPerformanceFrequency(&proc_freq);
+  (void)getProcFreq();
 #endif
 }
 
+static std::mutex timerUsersMutex;
+static unsigned timerUsers = 0;
+
+void holdTimers() {
+  std::lock_guard<std::mutex> lock(timerUsersMutex);
+  if (timerUsers++ == 0)
+    initTimer();
+}
+
+void releaseTimers() {
+  std::lock_guard<std::mutex> lock(timerUsersMutex);
+  vASSERT(timerUsers > 0);
+  --timerUsers;
+}
+
 void resetPerKernel() {
   for (int i = 0; i < static_cast<int>(TimerID::NUM_TIMERS); i++) {
     TimerID ti = static_cast<TimerID>(i);
@@ -140,17 +191,17 @@ void resetPerKernel() {
         ti == TimerID::VISA_BUILDER_IR_CONSTRUCTION) {
       continue;
     }
-    timers[i].time = 0;
-    timers[i].currentStart = 0;
-    timers[i].ticks = 0;
-    timers[i].started = false;
-    timers[i].hits = 0;
+    timers[i].ticks.store(0, std::memory_order_relaxed);
+    timers[i].hits.store(0, std::memory_order_relaxed);
+    runningTimers[i].currentStart = 0;
+    runningTimers[i].started = false;
   }
 }
 
+// All the timers are defined in TimerDefs.h, so there is no room for more.
 int createNewTimer(const char *name) {
-  timers[numTimers].name = name;
-  return numTimers++;
+  vASSERT(false);
+  return -1;
 }
 
 void startTimer(TimerID timerId) {
@@ -158,7 +209,7 @@ void startTimer(TimerID timerId) {
 #ifdef MEASURE_COMPILATION_TIME
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
 #if defined(_DEBUG) && defined(CHECK_TIMER)
-    if (timers[timer].started) {
+    if (runningTimers[timer].started) {
       std::cerr << "***********************************************\n";
       std::cerr << "Timer already started.\n";
       vASSERT(false);
@@ -166,10 +217,13 @@ void startTimer(TimerID timerId) {
 #endif
     LARGE_INTEGER start;
     QueryPerformanceCounter(&start);
-    timers[timer].currentStart = start.QuadPart;
-    timers[timer].hits++;
+    runningTimers[timer].currentStart = start.QuadPart;
+    timers[timer].hits.fetch_add(1, std::memory_order_relaxed);
+    if (timerEventCallback.load(std::memory_order_relaxed)) {
+      timerEventStart[timer] = timerEventNow();
+    }
 #if defined(_DEBUG) && defined(CHECK_TIMER)
-    timers[timer].started = true;
+    runningTimers[timer].started = true;
 #endif
   } else {
 #ifdef _DEBUG
@@ -186,12 +240,15 @@ void stopTimer(TimerID timerId) {
   if (timer < static_cast<int>(TimerID::NUM_TIMERS)) {
     LARGE_INTEGER stop;
     QueryPerformanceCounter(&stop);
-    timers[timer].time += (stop.QuadPart - timers[timer].currentStart) /
-                          (double)proc_freq.QuadPart;
-    timers[timer].ticks += (stop.QuadPart - timers[timer].currentStart);
-    timers[timer].currentStart = 0;
+    timers[timer].ticks.fetch_add(stop.QuadPart -
+                                      runningTimers[timer].currentStart,
+                                  std::memory_order_relaxed);
+    runningTimers[timer].currentStart = 0;
+    if (auto callback = timerEventCallback.load(std::memory_order_relaxed)) {
+      callback(timer, timerEventStart[timer], timerEventNow());
+    }
 #if defined(_DEBUG) && defined(CHECK_TIMER)
-    timers[timer].started = false;
+    runningTimers[timer].started = false;
 #endif
   } else {
 #ifdef _DEBUG
@@ -204,12 +261,20 @@ void stopTimer(TimerID timerId) {
 
 extern "C" unsigned int getTotalTimers() { return numTimers; }
 
-extern "C" double getTimerCounts(unsigned int idx) { return timers[idx].time; }
+extern "C" void setTimerEventCallback(TimerEventCallback callback) {
+  timerEventCallback.store(callback);
+}
 
-extern "C" int64_t getTimerTicks(unsigned int idx) { return timers[idx].ticks; }
+extern "C" double getTimerCounts(unsigned int idx) {
+  return getTimerTime(idx);
+}
+
+extern "C" int64_t getTimerTicks(unsigned int idx) {
+  return timers[idx].ticks.load(std::memory_order_relaxed);
+}
 
 extern "C" unsigned int getTimerHits(unsigned int idx) {
-  return timers[idx].hits;
+  return timers[idx].hits.load(std::memory_order_relaxed);
 }
 
 // static double getTimerUS(unsigned int idx)
@@ -224,7 +289,7 @@ void dumpAllTimers(const char *asmFileName, bool outputTime) {
   std::ofstream krnlOutput;
   krnlOutput.open("jit_time.txt", std::ios_base::app);
 
-  double totalTime = timers[static_cast<int>(TimerID::TOTAL)].time;
+  double totalTime = getTimerTime(static_cast<int>(TimerID::TOTAL));
   for (unsigned int i = 0; i < getTotalTimers(); i++) {
 #ifndef TIME_BUILDER
     TimerID ti = static_cast<TimerID>(i);
@@ -238,11 +303,11 @@ void dumpAllTimers(const char *asmFileName, bool outputTime) {
     krnlOutput << std::left << std::setw(24) << timerNames[i] << "\t";
     if (outputTime) {
       krnlOutput << std::left << std::setw(12) << std::setprecision(6)
-                 << timers[i].time << "\t";
+                 << getTimerTime(i) << "\t";
     } else {
-      krnlOutput << timers[i].ticks << "\t";
+      krnlOutput << getTimerTicks(i) << "\t";
     }
-    krnlOutput << std::setprecision(4) << (timers[i].time / totalTime * 100)
+    krnlOutput << std::setprecision(4) << (getTimerTime(i) / totalTime * 100)
                << "%";
     krnlOutput << "\n";
   }
@@ -260,9 +325,9 @@ void dumpAllTimers(const char *asmFileName, bool outputTime) {
   for (unsigned i = 0, e = getTotalTimers(); i < e; i++) {
     timerFile << timerNames[i] << ":";
     if (outputTime) {
-      timerFile << timers[i].time << "\n";
+      timerFile << getTimerTime(i) << "\n";
     } else {
-      timerFile << timers[i].ticks << "\n";
+      timerFile << getTimerTicks(i) << "\n";
     }
   }
   timerFile.close();
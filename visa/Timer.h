@@ -39,6 +39,11 @@ enum class TimerID {
 
 int createNewTimer(const char *timerName);
 void initTimer();
+// Builders alive at the same time share the timers: only the first one of
+// them resets them, so that they don't clear each other's times. Each
+// holdTimers() is paired with a releaseTimers().
+void holdTimers();
+void releaseTimers();
 void startTimer(TimerID timer);
 void stopTimer(TimerID timer);
 void dumpAllTimers(const char *asmFileName, bool outputTime = false);
@@ -34,3 +34,4 @@ DEF_TIMER(VISA_BUILDER_CREATE_OPND, "VB_Create_Operand")
 DEF_TIMER(VISA_BUILDER_IR_CONSTRUCTION, "VB_IR_Construction")
 DEF_TIMER(LIVENESS, "liveness")
 DEF_TIMER(RPE, "Reg Pressure Estimate")
+DEF_TIMER(SWSB_GLOBAL_DATAFLOW, "\t  SWSB_Global_Dataflow")
@@ -20,6 +20,7 @@ SPDX-License-Identifier: MIT
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -1114,6 +1115,9 @@ public:
   void setOutputAsmPath(std::string val) { m_asmName = val; }
 
   int compileFastPath();
+  // Compile with a private copy of the builder's options from now on, so
+  // that the changes the compilation makes to them stay with this kernel.
+  void useOwnOptions();
 
   unsigned int m_magic_number;
   unsigned char m_major_version;
@@ -1379,8 +1383,10 @@ private:
 
   void computeFCInfo(vISA::BinaryEncodingBase *binEncodingInstance);
   void computeFCInfo();
-  // memory managed by the entity that creates vISA Kernel object
-  Options *const m_options;
+  // memory managed by the entity that creates vISA Kernel object, unless
+  // useOwnOptions() has made the kernel its own copy
+  Options *m_options;
+  std::unique_ptr<Options> m_ownOptions;
 
   void createKernelAttributes() { m_kernelAttrs = new vISA::Attributes(); }
   void destroyKernelAttributes() { delete m_kernelAttrs; }
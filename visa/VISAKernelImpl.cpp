@@ -119,6 +119,15 @@ int VISAKernelImpl::calculateTotalInputSize() {
   return VISA_SUCCESS;
 }
 
+void VISAKernelImpl::useOwnOptions() {
+  if (m_ownOptions)
+    return;
+  m_ownOptions = std::make_unique<Options>(*m_options);
+  m_options = m_ownOptions.get();
+  m_kernel->setOptions(m_options);
+  m_builder->setOptions(m_options);
+}
+
 int VISAKernelImpl::compileFastPath() {
   int status = VISA_SUCCESS;
 
@@ -145,11 +154,27 @@ int VISAKernelImpl::compileFastPath() {
     return status;
   }
 
+  ArenaStats arenaStart = ArenaChunkPool::getStats();
+  size_t outerArenaPeak = ArenaChunkPool::beginPhase();
+
   IR_Builder &builder = *m_builder;
   builder.predefinedVarRegAssignment((uint8_t)m_inputSize);
   builder.expandPredefinedVars();
   builder.resizePredefinedStackVars();
   status = compileTillOptimize();
+
+  size_t arenaPeak = ArenaChunkPool::endPhase(outerArenaPeak);
+  if (m_options->getOption(vISA_DumpPerfStatsVerbose)) {
+    const ArenaStats &arenaEnd = ArenaChunkPool::getStats();
+    auto &stats = m_jitInfo->statsVerbose;
+    stats.arenaBytesRequested =
+        arenaEnd.bytesRequested - arenaStart.bytesRequested;
+    stats.arenaChunksAllocated =
+        (uint32_t)(arenaEnd.chunksAllocated - arenaStart.chunksAllocated);
+    stats.arenaChunksReused =
+        (uint32_t)(arenaEnd.chunksReused - arenaStart.chunksReused);
+    stats.arenaPeakBytes = arenaPeak;
+  }
   return status;
 }
 
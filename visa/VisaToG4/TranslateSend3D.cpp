@@ -1263,7 +1263,6 @@ Need to split sample_d and sample_dc in to two simd8 sends since HW doesn't
 support it. Also need to split any sample instruciton that has more then 5
 parameters. Since there is a limit on msg length.
 */
-static unsigned TmpSmplDstID = 0;
 
 // split simd32/16 sampler messages into simd16/8 messages due to HW limitation.
 int IR_Builder::splitSampleInst(
@@ -1313,7 +1312,7 @@ int IR_Builder::splitSampleInst(
       ++tmpDstRows;
     }
 
-    const char *name = getNameString(20, "%s%d", "TmpSmplDst_", TmpSmplDstID++);
+    const char *name = getNameString(20, "%s%d", "TmpSmplDst_", numTmpSmplDst++);
 
     tempDstDcl = createDeclare(
         name, originalDstDcl->getRegFile(), originalDstDcl->getNumElems(),
@@ -1406,7 +1405,7 @@ int IR_Builder::splitSampleInst(
   G4_Declare *tempDstDcl2 = nullptr;
   if (!dst->isNullReg()) {
     const char *name =
-        getNameString(20, "%s%d", "TmpSmplDst2_", TmpSmplDstID++);
+        getNameString(20, "%s%d", "TmpSmplDst2_", numTmpSmplDst++);
 
     tempDstDcl2 = createDeclare(
         name, originalDstDcl->getRegFile(), originalDstDcl->getNumElems(),
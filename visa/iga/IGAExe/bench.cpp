@@ -0,0 +1,95 @@
+/*========================== begin_copyright_notice ============================
+
+Copyright (C) 2023 Intel Corporation
+
+SPDX-License-Identifier: MIT
+
+============================= end_copyright_notice ===========================*/
+
+#include "iga_main.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// each configuration is repeated until it has run for at least this long
+static const double MIN_BENCH_SECONDS = 0.5;
+
+static bool runBatch(iga_context_t ctx, const iga_disassemble_options_t &dopts,
+                     uint32_t threads,
+                     std::vector<iga_disassemble_batch_entry_t> &entries) {
+  uint64_t insts = 0;
+  int reps = 0;
+  double secs = 0.0;
+  do {
+    auto start = std::chrono::steady_clock::now();
+    iga_status_t st = iga_context_disassemble_batch(
+        ctx, &dopts, threads, entries.data(), (uint32_t)entries.size());
+    secs += std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                          start)
+                .count();
+    if (st != IGA_SUCCESS) {
+      std::cerr << "iga_context_disassemble_batch: "
+                << iga_status_to_string(st) << "\n";
+      for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].status != IGA_SUCCESS) {
+          std::cerr << "  kernel " << i << ": "
+                    << iga_status_to_string(entries[i].status) << "\n";
+        }
+      }
+      return false;
+    }
+    reps++;
+  } while (secs < MIN_BENCH_SECONDS);
+
+  for (const auto &e : entries)
+    insts += e.num_instructions;
+  double perRep = secs / reps;
+  std::cout << std::setw(8) << (threads == 0 ? std::string("all")
+                                             : std::to_string(threads))
+            << std::setw(10) << entries.size() << std::setw(14) << insts
+            << std::setw(8) << reps << std::setw(12) << std::fixed
+            << std::setprecision(6) << perRep << std::setw(16)
+            << std::setprecision(0) << (perRep > 0 ? insts / perRep : 0.0)
+            << "\n";
+  return true;
+}
+
+// -Xbench: disassembles all the input files as one batch, first on a single
+// thread and then on the requested number of threads, and reports the
+// throughput of each in instructions per second
+bool benchmarkDisassembly(const Opts &opts) {
+  std::vector<std::vector<unsigned char>> inputs(opts.inputFiles.size());
+  std::vector<iga_disassemble_batch_entry_t> entries(opts.inputFiles.size());
+  for (size_t i = 0; i < opts.inputFiles.size(); i++) {
+    readBinaryFile(opts.inputFiles[i].c_str(), inputs[i]);
+    entries[i] = iga_disassemble_batch_entry_t();
+    entries[i].input = inputs[i].data();
+    entries[i].input_size = (uint32_t)inputs[i].size();
+  }
+
+  iga_context_options_t copts = IGA_CONTEXT_OPTIONS_INIT(opts.platform);
+  iga_context_t ctx;
+  iga_status_t st = iga_context_create(&copts, &ctx);
+  if (st != IGA_SUCCESS) {
+    fatalExitWithMessage("iga_context_create: ", iga_status_to_string(st));
+  }
+
+  iga_disassemble_options_t dopts = IGA_DISASSEMBLE_OPTIONS_INIT();
+  dopts.formatting_opts = makeFormattingOpts(opts);
+  dopts.base_pc_offset = opts.pcOffset;
+  setOptBit(dopts.decoder_opts, IGA_DECODING_OPT_NATIVE, opts.useNativeEncoder);
+
+  std::cout << std::setw(8) << "threads" << std::setw(10) << "kernels"
+            << std::setw(14) << "instructions" << std::setw(8) << "reps"
+            << std::setw(12) << "secs/rep" << std::setw(16) << "insts/sec"
+            << "\n";
+  bool success = runBatch(ctx, dopts, 1, entries);
+  if (success && opts.benchThreads != 1)
+    success = runBatch(ctx, dopts, opts.benchThreads, entries);
+
+  iga_context_release(ctx);
+  return success;
+}
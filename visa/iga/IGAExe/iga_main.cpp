@@ -253,6 +253,20 @@ extern "C" int iga_main(int argc, const char **argv) {
                   "set in instruction option."
                   "This will override the effect by -Xautocompact",
                   opts::OptAttrs::ALLOW_UNSET, baseOpts.forceNoCompact);
+  xGrp.defineOpt(
+      "bench", nullptr, "INT", "benchmark batch disassembly",
+      "This mode disassembles all the input files as one batch, first on a "
+      "single thread and then on the given number of threads (0 means one "
+      "per hardware thread), and reports the throughput in instructions "
+      "per second.  The platform must be given or inferable from the "
+      "first file's extension.\n"
+      "EXAMPLES:\n"
+      "  % iga -p=xehp -Xbench=8 *.krn\n",
+      opts::OptAttrs::ALLOW_UNSET,
+      [](const char *cinp, const opts::ErrorHandler &eh, Opts &baseOpts) {
+        baseOpts.mode = Opts::Mode::XBENCH;
+        baseOpts.benchThreads = cinp ? (uint32_t)eh.parseInt(cinp) : 0;
+      });
   xGrp.defineFlag(
       "dcmp", nullptr, "debug compaction",
       "This mode debugs an instruction's compaction.  The input format "
@@ -477,6 +491,19 @@ extern "C" int iga_main(int argc, const char **argv) {
     hasError |= debugCompaction(baseOpts);
   } else if (baseOpts.mode == Opts::Mode::XDSD) {
     hasError |= decodeSendDescriptor(baseOpts);
+  } else if (baseOpts.mode == Opts::Mode::XBENCH) {
+    if (baseOpts.inputFiles.empty()) {
+      fatalExitWithMessage("-Xbench requires at least one file");
+    }
+    Opts opts = baseOpts;
+    if (opts.platform == IGA_GEN_INVALID) {
+      inferPlatformAndMode(opts.inputFiles.front(), opts);
+      if (opts.platform == IGA_GEN_INVALID) {
+        fatalExitWithMessage("-Xbench: cannot infer project based on file "
+                             "extension (use -p=...)");
+      }
+    }
+    hasError |= !benchmarkDisassembly(opts);
   } else {
     if (baseOpts.inputFiles.empty()) {
       fatalExitWithMessage("at least one file required");
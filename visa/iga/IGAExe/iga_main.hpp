@@ -37,7 +37,8 @@ struct Opts {
   // XIFS = -Xifs (decode fields)
   // XDCMP = -Xdcmp (debug compaction)
   // AUTO = operate based on input (see inferPlatformAndMode below)
-  enum class Mode { ASM, DIS, XLST, XIFS, XDCMP, XDSD, AUTO };
+  // XBENCH = -Xbench (batch disassembly throughput)
+  enum class Mode { ASM, DIS, XLST, XIFS, XDCMP, XDSD, XBENCH, AUTO };
   enum class Color { NEVER, AUTO, ALWAYS };
 
   std::vector<std::string> inputFiles;             // .empty() means stdin
@@ -58,6 +59,7 @@ struct Opts {
   bool useNativeEncoder = false;                   // -Xnative
   bool forceNoCompact = false;                     // -Xforce-no-compact
   uint32_t pcOffset = 0; // pcOffset provided with -Xset-pc-base
+  uint32_t benchThreads = 0; // -Xbench=...
 
   bool printBits = false;          // -Xprint-bits
   bool printDefs = false;          // -Xprint-defs
@@ -83,6 +85,7 @@ bool debugCompaction(Opts opts); // -Xdcmp in decode_fields.cpp
 bool listOps(const Opts &opts,
              const std::string &opmn);       // -Xlist-ops: list_ops.cpp
 bool decodeSendDescriptor(const Opts &opts); // -Xsds in decode_message.cpp
+bool benchmarkDisassembly(const Opts &opts); // -Xbench in bench.cpp
 
 static inline void setOptBit(uint32_t &opts, uint32_t bit, bool isSet) {
   if (isSet) {
@@ -25,10 +25,13 @@ SPDX-License-Identifier: MIT
 
 // external dependencies
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <map>
 #include <ostream>
 #include <sstream>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -198,6 +201,9 @@ private:
   char *m_disassemble_text;
   // a reusable empty string to return on errors
   char m_empty_string[4];
+  // cached results of the last batch call, one per entry
+  std::vector<std::string> m_batch_text;
+  std::vector<std::vector<unsigned char>> m_batch_bits;
 
   // diagnostics from the last compile
   bool m_errorsValid, m_warningsValid;
@@ -293,9 +299,16 @@ public:
 
   bool valid() const { return m_validToken == VALID_COOKIE; }
 
-  iga_status_t assemble(iga_assemble_options_t &aopts, const char *inp,
-                        void **bits, uint32_t *bitsLen32) {
-    iga::ErrorHandler errHandler;
+  // Parses, checks and encodes a kernel.  This touches none of the context's
+  // cached results or diagnostics, so batch workers may call it at the same
+  // time.  Upon IGA_SUCCESS or IGA_ENCODE_ERROR 'bits' lives in the kernel's
+  // memory and is valid until the kernel is deleted.
+  iga_status_t assembleKernel(iga_assemble_options_t &aopts, const char *inp,
+                              iga::ErrorHandler &errHandler, Kernel *&pKernel,
+                              void *&bits, size_t &bitsLen) const {
+    pKernel = nullptr;
+    bits = nullptr;
+    bitsLen = 0;
     // compatibility for legacy fields
     bool used_legacy_fields = false;
     if (aopts._reserved0) { // used to be error_on_compact_fail
@@ -320,35 +333,21 @@ public:
     ParseOpts popts(m_model);
     popts.supportLegacyDirectives =
         (aopts.syntax_opts & IGA_SYNTAX_OPT_LEGACY_SYNTAX) != 0;
-    Kernel *pKernel = iga::ParseGenKernel(m_model, inp, errHandler, popts);
+    pKernel = iga::ParseGenKernel(m_model, inp, errHandler, popts);
     if (pKernel && !errHandler.hasErrors() && aopts.enabled_warnings) {
       // check semantics if we parsed without error && they haven't
       // disabled all checking (-Wnone)
       CheckSemantics(*pKernel, errHandler, aopts.enabled_warnings);
     }
     if (errHandler.hasErrors()) {
-      *bits = nullptr;
-      *bitsLen32 = 0;
-      iga_status_t st = translateDiagnostics(errHandler);
-      if (pKernel)
-        delete pKernel;
-      return (st != IGA_SUCCESS) ? st : IGA_PARSE_ERROR;
+      return IGA_PARSE_ERROR;
     } else if (pKernel == nullptr) {
       // parser returned nullptr for kernel, but with no errors
       // shouldn't be reachable; implies we have a missing diagnostic
-      if (pKernel)
-        delete pKernel;
       return IGA_ERROR;
     }
 
     // 3. Encode the final IR into bits
-    //
-    // clobber the last assembly's bits
-    if (m_assemble_bits) {
-      free(m_assemble_bits);
-      m_assemble_bits = nullptr;
-    }
-    size_t bitsLen = 0;
     EncoderOpts eopts(
         (aopts.encoder_opts & IGA_ENCODER_OPT_AUTO_COMPACT) != 0,
         (aopts.encoder_opts & IGA_ENCODER_OPT_ERROR_ON_COMPACT_FAIL) == 0,
@@ -360,27 +359,53 @@ public:
 
     if ((aopts.encoder_opts & IGA_ENCODER_OPT_USE_NATIVE) == 0) {
       if (!iga::ged::IsEncodeSupported(m_model, eopts)) {
-        delete pKernel;
         return IGA_UNSUPPORTED_PLATFORM;
       }
-      iga::ged::Encode(m_model, eopts, errHandler, *pKernel, *bits, bitsLen);
+      iga::ged::Encode(m_model, eopts, errHandler, *pKernel, bits, bitsLen);
     } else {
       if (!iga::native::IsEncodeSupported(m_model, eopts)) {
-        delete pKernel;
         return IGA_UNSUPPORTED_PLATFORM;
       }
-      iga::native::Encode(m_model, eopts, errHandler, *pKernel, *bits, bitsLen);
+      iga::native::Encode(m_model, eopts, errHandler, *pKernel, bits, bitsLen);
+    }
+    return errHandler.hasErrors() ? IGA_ENCODE_ERROR : IGA_SUCCESS;
+  }
+
+  iga_status_t assemble(iga_assemble_options_t &aopts, const char *inp,
+                        void **bits, uint32_t *bitsLen32) {
+    iga::ErrorHandler errHandler;
+    Kernel *pKernel = nullptr;
+    void *encodedBits = nullptr;
+    size_t bitsLen = 0;
+    iga_status_t st =
+        assembleKernel(aopts, inp, errHandler, pKernel, encodedBits, bitsLen);
+    if (st == IGA_PARSE_ERROR) {
+      *bits = nullptr;
+      *bitsLen32 = 0;
+      st = translateDiagnostics(errHandler);
+      if (pKernel)
+        delete pKernel;
+      return (st != IGA_SUCCESS) ? st : IGA_PARSE_ERROR;
+    } else if (st != IGA_SUCCESS && st != IGA_ENCODE_ERROR) {
+      if (pKernel)
+        delete pKernel;
+      return st;
     }
+    *bits = encodedBits;
     *bitsLen32 = (uint32_t)bitsLen;
-    if (errHandler.hasErrors()) {
+    if (st == IGA_ENCODE_ERROR) {
       // failed encoding
       delete pKernel;
-      iga_status_t st = translateDiagnostics(errHandler);
+      st = translateDiagnostics(errHandler);
       return st == IGA_SUCCESS ? IGA_ENCODE_ERROR : st;
     }
 
     // 4. Copy out the result
-    // encoding succeeded, copy the bits out
+    // encoding succeeded, clobber the last assembly's bits and copy them out
+    if (m_assemble_bits) {
+      free(m_assemble_bits);
+      m_assemble_bits = nullptr;
+    }
     m_assemble_bits = (void *)malloc(*bitsLen32);
     if (!m_assemble_bits) {
       delete pKernel;
@@ -397,7 +422,7 @@ public:
       const char *(*formatLabel)(int32_t, void *), void *formatLabelEnv,
       // swsb encoding mode, if not specified, the encoding mode will
       // be derived from platform by SWSB::getEncdoeMode
-      SWSB_ENCODE_MODE swsbEnMod = SWSB_ENCODE_MODE::SWSBInvalidMode) {
+      SWSB_ENCODE_MODE swsbEnMod = SWSB_ENCODE_MODE::SWSBInvalidMode) const {
     FormatOpts fopts(m_model, formatLabel, formatLabelEnv);
     fopts.addApiOpts(dopts.formatting_opts, dopts.base_pc_offset);
     if (swsbEnMod == SWSB_ENCODE_MODE::SWSBInvalidMode)
@@ -409,7 +434,7 @@ public:
   }
 
   void checkForLegacyFields(iga_disassemble_options_t &dopts,
-                            iga::ErrorHandler &errHandler) {
+                            iga::ErrorHandler &errHandler) const {
     // crude compatibility for legacy fields
     bool used_legacy_fields = false;
     if (dopts._reserved0) { // used to be hex_floats
@@ -431,7 +456,7 @@ public:
   iga_status_t disassembleKernel(iga::ErrorHandler &errHandler,
                                  iga_disassemble_options_t &dopts,
                                  const void *bits, uint32_t bitsLen,
-                                 Kernel *&k) {
+                                 Kernel *&k) const {
     k = nullptr;
     checkForLegacyFields(dopts, errHandler);
     DecoderOpts dopts2(
@@ -503,6 +528,152 @@ public:
     return st;
   }
 
+  // Decodes and formats one entry of a batch; called on the worker threads.
+  iga_status_t disassembleBatchEntry(iga_disassemble_options_t dopts,
+                                     iga_disassemble_batch_entry_t &e,
+                                     iga::ErrorHandler &errHandler,
+                                     std::string &text) const {
+    iga::Kernel *k = nullptr;
+    iga_status_t st = IGA_ERROR;
+    try {
+      st = disassembleKernel(errHandler, dopts, e.input, e.input_size, k);
+      if (k != nullptr) {
+        std::stringstream ss;
+        FormatOpts fopts = formatterOpts(dopts, nullptr, nullptr);
+        if (dopts.formatting_opts & IGA_FORMATTING_OPT_PRINT_DEFS) {
+          k->resetIds();
+          fopts.printInstDefs = true;
+        }
+        FormatKernel(errHandler, ss, fopts, *k, e.input);
+        text = ss.str();
+        e.num_instructions = (uint32_t)k->getInstructionCount();
+        delete k;
+      }
+    } catch (const iga::FatalError &) {
+      delete k;
+      st = IGA_ERROR;
+    } catch (const std::bad_alloc &) {
+      delete k;
+      st = IGA_OUT_OF_MEM;
+    }
+    return errHandler.hasErrors() ? IGA_DECODE_ERROR : st;
+  }
+
+  iga_status_t assembleBatchEntry(iga_assemble_options_t aopts,
+                                  iga_assemble_batch_entry_t &e,
+                                  iga::ErrorHandler &errHandler,
+                                  std::vector<unsigned char> &output) const {
+    Kernel *pKernel = nullptr;
+    iga_status_t st = IGA_ERROR;
+    try {
+      void *bits = nullptr;
+      size_t bitsLen = 0;
+      st = assembleKernel(aopts, e.kernel_text, errHandler, pKernel, bits,
+                          bitsLen);
+      if (st == IGA_SUCCESS) {
+        const unsigned char *ubits = (const unsigned char *)bits;
+        output.assign(ubits, ubits + bitsLen);
+      }
+    } catch (const iga::FatalError &) {
+      st = IGA_ERROR;
+    } catch (const std::bad_alloc &) {
+      st = IGA_OUT_OF_MEM;
+    }
+    delete pKernel;
+    return st;
+  }
+
+  // Runs 'work(i)' for each entry index on up to 'numThreads' threads
+  // (0 means one per hardware thread).  Entries are handed out one at a
+  // time so that a few large kernels don't leave the other threads idle.
+  template <typename F>
+  static void parallelFor(uint32_t numThreads, uint32_t numEntries, F work) {
+    if (numThreads == 0)
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, numEntries);
+
+    std::atomic<uint32_t> next(0);
+    auto worker = [&]() {
+      for (uint32_t i = next++; i < numEntries; i = next++)
+        work(i);
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < numThreads; t++) {
+      try {
+        threads.emplace_back(worker);
+      } catch (const std::system_error &) {
+        break; // make do with the threads we got
+      }
+    }
+    worker();
+    for (auto &t : threads)
+      t.join();
+  }
+
+  // The batch status is that of the first failing entry; its diagnostics
+  // (or those of the first entry with warnings) become the context's.
+  template <typename Entry>
+  iga_status_t finishBatch(const Entry *entries, uint32_t numEntries,
+                           const std::vector<iga::ErrorHandler> &errHandlers) {
+    uint32_t failed = numEntries, warned = numEntries;
+    for (uint32_t i = 0; i < numEntries && failed == numEntries; i++) {
+      if (entries[i].status != IGA_SUCCESS)
+        failed = i;
+      else if (warned == numEntries && errHandlers[i].hasWarnings())
+        warned = i;
+    }
+    iga::ErrorHandler none;
+    const iga::ErrorHandler &eh = failed < numEntries   ? errHandlers[failed]
+                                  : warned < numEntries ? errHandlers[warned]
+                                                        : none;
+    iga_status_t st = translateDiagnostics(eh);
+    if (st != IGA_SUCCESS)
+      return st;
+    return failed < numEntries ? entries[failed].status : IGA_SUCCESS;
+  }
+
+  iga_status_t disassembleBatch(const iga_disassemble_options_t &dopts,
+                                uint32_t numThreads,
+                                iga_disassemble_batch_entry_t *entries,
+                                uint32_t numEntries) {
+    // the previous batch's text is clobbered
+    m_batch_text.clear();
+    m_batch_text.resize(numEntries);
+    std::vector<iga::ErrorHandler> errHandlers(numEntries);
+
+    parallelFor(numThreads, numEntries, [&](uint32_t i) {
+      entries[i].num_instructions = 0;
+      entries[i].status = disassembleBatchEntry(dopts, entries[i],
+                                                errHandlers[i], m_batch_text[i]);
+    });
+    for (uint32_t i = 0; i < numEntries; i++)
+      entries[i].kernel_text = m_batch_text[i].c_str();
+
+    return finishBatch(entries, numEntries, errHandlers);
+  }
+
+  iga_status_t assembleBatch(const iga_assemble_options_t &aopts,
+                             uint32_t numThreads,
+                             iga_assemble_batch_entry_t *entries,
+                             uint32_t numEntries) {
+    // the previous batch's bits are clobbered
+    m_batch_bits.clear();
+    m_batch_bits.resize(numEntries);
+    std::vector<iga::ErrorHandler> errHandlers(numEntries);
+
+    parallelFor(numThreads, numEntries, [&](uint32_t i) {
+      entries[i].status = assembleBatchEntry(aopts, entries[i], errHandlers[i],
+                                             m_batch_bits[i]);
+    });
+    for (uint32_t i = 0; i < numEntries; i++) {
+      bool ok = entries[i].status == IGA_SUCCESS;
+      entries[i].output = ok ? m_batch_bits[i].data() : nullptr;
+      entries[i].output_size = ok ? (uint32_t)m_batch_bits[i].size() : 0;
+    }
+
+    return finishBatch(entries, numEntries, errHandlers);
+  }
+
   iga_status_t disassembleInstruction(iga_disassemble_options_t &dopts,
                                       const void *bits,
                                       const char *(*formatLbl)(int32_t, void *),
@@ -713,6 +884,54 @@ iga_status_t iga_disassemble_instruction(
   return iga_context_disassemble_instruction(ctx, dopts, input, fmt_label_name,
                                              fmt_label_ctx, kernel_text);
 }
+
+iga_status_t iga_context_disassemble_batch(
+    iga_context_t ctx, const iga_disassemble_options_t *dopts,
+    uint32_t num_threads, iga_disassemble_batch_entry_t *entries,
+    uint32_t num_entries) {
+  RETURN_INVALID_ARG_ON_NULL(ctx);
+  RETURN_INVALID_ARG_ON_NULL(dopts);
+  if (entries == nullptr && num_entries != 0)
+    return IGA_INVALID_ARG;
+  for (uint32_t i = 0; i < num_entries; i++) {
+    if (entries[i].input == nullptr && entries[i].input_size != 0)
+      return IGA_INVALID_ARG;
+  }
+  if (dopts->cb > sizeof(*dopts)) {
+    return IGA_VERSION_ERROR;
+  }
+  iga_disassemble_options_t doptsInternal = IGA_DISASSEMBLE_OPTIONS_INIT();
+  memcpy_s(&doptsInternal, dopts->cb, dopts, dopts->cb);
+
+  CAST_CONTEXT(ctx_obj, ctx);
+  return ctx_obj->disassembleBatch(doptsInternal, num_threads, entries,
+                                   num_entries);
+}
+
+iga_status_t iga_context_assemble_batch(iga_context_t ctx,
+                                        const iga_assemble_options_t *aopts,
+                                        uint32_t num_threads,
+                                        iga_assemble_batch_entry_t *entries,
+                                        uint32_t num_entries) {
+  RETURN_INVALID_ARG_ON_NULL(ctx);
+  RETURN_INVALID_ARG_ON_NULL(aopts);
+  if (entries == nullptr && num_entries != 0)
+    return IGA_INVALID_ARG;
+  for (uint32_t i = 0; i < num_entries; i++) {
+    RETURN_INVALID_ARG_ON_NULL(entries[i].kernel_text);
+  }
+  // see note at the top of the file about binary compatibility
+  if (aopts->cb > sizeof(*aopts)) {
+    return IGA_VERSION_ERROR;
+  }
+  iga_assemble_options_t aoptsInternal = IGA_ASSEMBLE_OPTIONS_INIT();
+  memcpy_s(&aoptsInternal, aopts->cb, aopts, aopts->cb);
+
+  CAST_CONTEXT(ctx_obj, ctx);
+  return ctx_obj->assembleBatch(aoptsInternal, num_threads, entries,
+                                num_entries);
+}
+
 iga_status_t iga_context_disassemble_instruction(
     iga_context_t ctx, const iga_disassemble_options_t *dopts,
     const void *input, const char *(*fmt_label_name)(int32_t, void *),
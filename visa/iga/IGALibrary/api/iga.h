@@ -528,6 +528,88 @@ IGA_API iga_status_t iga_disassemble_instruction(
     const void *input, const char *(*fmt_label_name)(int32_t, void *),
     void *fmt_label_ctx, char **kernel_text);
 
+/*****************************************************************************/
+/*                  Batch Functions                                          */
+/*****************************************************************************/
+
+/*
+ * One kernel of a batch disassembly.
+ */
+typedef struct {
+  /* in: the instructions to disassemble */
+  const void *input;
+  /* in: the size of 'input' in bytes */
+  uint32_t input_size;
+  /* out: the status of this kernel (as 'iga_context_disassemble' returns) */
+  iga_status_t status;
+  /* out: the NUL-terminated disassembly text (same lifetime rules as
+   * 'iga_context_disassemble'); never NULL after the call */
+  const char *kernel_text;
+  /* out: the number of instructions decoded */
+  uint32_t num_instructions;
+  uint32_t _reserved;
+} iga_disassemble_batch_entry_t;
+
+/*
+ * Disassembles many kernels at once, spreading them over 'num_threads'
+ * worker threads.  Each kernel is decoded and formatted independently
+ * (with its own IR arena), so the result for every entry is the same
+ * as 'iga_context_disassemble' would produce, and results land in the
+ * entry they came from regardless of the order the workers finish in.
+ * Label callbacks are not supported in batch mode.
+ *
+ * PARAMETERS:
+ *  ctx             an iga context
+ *  dopts           the disassemble options (used for all entries)
+ *  num_threads     the number of workers; 0 means one per hardware thread
+ *  entries         the kernels to disassemble
+ *  num_entries     the number of elements in 'entries'
+ *
+ * RETURNS:
+ *  IGA_SUCCESS         if every entry disassembled successfully
+ *  IGA_INVALID_ARG     if an argument is NULL
+ *  IGA_INVALID_OBJECT  if ctx has already been destroyed
+ *  IGA_DECODE_ERROR    (or another error) if any entry failed; the
+ *                      diagnostics retrieved via 'iga_context_get_errors'
+ *                      and 'iga_context_get_warnings' are those of the
+ *                      first failing entry (or of the first entry with
+ *                      warnings upon success)
+ */
+IGA_API iga_status_t iga_context_disassemble_batch(
+    iga_context_t ctx, const iga_disassemble_options_t *dopts,
+    uint32_t num_threads, iga_disassemble_batch_entry_t *entries,
+    uint32_t num_entries);
+
+/*
+ * One kernel of a batch assembly.
+ */
+typedef struct {
+  /* in: a NUL-terminated string containing the kernel text */
+  const char *kernel_text;
+  /* out: the status of this kernel (as 'iga_context_assemble' returns) */
+  iga_status_t status;
+  /* out: the length of 'output' in bytes; 0 upon failure */
+  uint32_t output_size;
+  /* out: the assembled bits (same lifetime rules as 'iga_context_assemble');
+   * NULL upon failure */
+  const void *output;
+} iga_assemble_batch_entry_t;
+
+/*
+ * The assembly counterpart of 'iga_context_disassemble_batch'.
+ *
+ * RETURNS:
+ *  IGA_SUCCESS         if every entry assembled successfully
+ *  IGA_INVALID_ARG     if an argument is NULL
+ *  IGA_INVALID_OBJECT  if ctx has already been destroyed
+ *  IGA_PARSE_ERROR     (or another error) if any entry failed; see
+ *                      'iga_context_disassemble_batch' for diagnostics
+ */
+IGA_API iga_status_t iga_context_assemble_batch(
+    iga_context_t ctx, const iga_assemble_options_t *aopts,
+    uint32_t num_threads, iga_assemble_batch_entry_t *entries,
+    uint32_t num_entries);
+
 /*****************************************************************************/
 /*             Diagnostic Processing Functions                               */
 /*****************************************************************************/
@@ -82,6 +82,18 @@ typedef iga_status_t(CDECLATTRIBUTE *pIGADisassembleInstruction)(
     const void *input, const char *(*fmt_label_name)(int32_t, void *),
     void *fmt_label_ctx, char **kernel_text);
 
+#define IGA_CONTEXT_DISASSEMBLE_BATCH_STR "iga_context_disassemble_batch"
+typedef iga_status_t(CDECLATTRIBUTE *pIGAContextDisassembleBatch)(
+    iga_context_t ctx, const iga_disassemble_options_t *dopts,
+    uint32_t num_threads, iga_disassemble_batch_entry_t *entries,
+    uint32_t num_entries);
+
+#define IGA_CONTEXT_ASSEMBLE_BATCH_STR "iga_context_assemble_batch"
+typedef iga_status_t(CDECLATTRIBUTE *pIGAContextAssembleBatch)(
+    iga_context_t ctx, const iga_assemble_options_t *aopts,
+    uint32_t num_threads, iga_assemble_batch_entry_t *entries,
+    uint32_t num_entries);
+
 #define IGA_CONTEXT_GET_ERRORS_STR "iga_context_get_errors"
 typedef iga_status_t(CDECLATTRIBUTE *pIGAContextGetErrors)(
     iga_context_t ctx, const iga_diagnostic_t **ds, uint32_t *ds_len);
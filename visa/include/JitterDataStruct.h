@@ -80,6 +80,11 @@ public:
   uint32_t staticCycle = 0;
   uint32_t loopNestedStallCycle = 0;
   uint32_t loopNestedCycle = 0;
+
+  // Predicted EU cycles per work-item, from the loop-weighted cycles above,
+  // the SIMD size and the number of threads that can hide send latency.
+  // Used by IGC to compare the SIMD variants of a kernel; 0 if unknown.
+  float cyclesPerWorkItem = 0;
 };
 
 // PERF_STATS_VERBOSE - the verbose vISA static performance stats.
@@ -151,6 +156,17 @@ struct PERF_STATS_VERBOSE {
   uint32_t normIntfNum = 0;
   // Number of SIMD inteference edges.
   uint32_t augIntfNum = 0;
+
+  // Arena memory used by the compilation of the kernel on the compiling
+  // thread: bytes asked of the arenas freed during the compilation, arena
+  // chunks taken from the system allocator and reused from the chunk pool,
+  // and the peak bytes held by arenas during the whole compilation and
+  // during RA.
+  uint64_t arenaBytesRequested = 0;
+  uint32_t arenaChunksAllocated = 0;
+  uint32_t arenaChunksReused = 0;
+  uint64_t arenaPeakBytes = 0;
+  uint64_t arenaRAPeakBytes = 0;
 };
 
 struct FINALIZER_INFO {
@@ -153,6 +153,8 @@ DEF_VISA_OPTION(vISA_ifCvt, ET_BOOL, "-noifcvt", UNUSED, true)
 DEF_VISA_OPTION(vISA_RegSharingHeuristics, ET_BOOL, "-regSharingHeuristics",
                 UNUSED, false)
 DEF_VISA_OPTION(vISA_LVN, ET_BOOL, "-nolvn", UNUSED, true)
+DEF_VISA_OPTION(vISA_LVNAcrossBBs, ET_BOOL, "-nolvnAcrossBBs",
+                "Limit LVN to single BBs instead of extended BBs", true)
 // only affects acc substitution for now
 DEF_VISA_OPTION(vISA_numGeneralAcc, ET_INT32, "-numGeneralAcc",
                 "USAGE: -numGeneralAcc <accNum>\n", 0)
@@ -224,6 +226,11 @@ DEF_VISA_OPTION(vISA_renderTargetWriteSendReloc, ET_BOOL,
         "Enables adding offsets of all Render Target Write send instructions to the relocation table.", false)
 DEF_VISA_OPTION(vISA_CodePatch, ET_INT32, "-codePatch", UNUSED, 0)
 DEF_VISA_OPTION(vISA_Linker, ET_INT32, "-linker", UNUSED, 0)
+DEF_VISA_OPTION(vISA_FinalizeThreads, ET_INT32, "-finalizeThreads",
+                "USAGE: -finalizeThreads <num> compiles up to <num> kernels "
+                "and functions of the builder concurrently before they are "
+                "stitched",
+                0)
 DEF_VISA_OPTION(vISA_SSOShifter, ET_INT32, "-paddingSSOShifter", UNUSED, 0)
 DEF_VISA_OPTION(vISA_SkipPaddingScratchSpaceSize, ET_INT32, "-skipPaddingScratchSpaceSize", UNUSED, 4096)
 DEF_VISA_OPTION(vISA_lscEnableImmOffsFor, ET_INT32, "-lscEnableImmOffsFor",
@@ -301,6 +308,11 @@ DEF_VISA_OPTION(vISA_LraFFWindowSize, ET_INT32, "-lraFFWindowSize", UNUSED, 12)
 DEF_VISA_OPTION(vISA_SplitGRFAlignedScalar, ET_BOOL, "-nosplitGRFalignedscalar",
                 UNUSED, true)
 DEF_VISA_OPTION(vISA_DoSplitOnSpill, ET_BOOL, "-nosplitonspill", UNUSED, true)
+DEF_VISA_OPTION(vISA_RALargerGRFOnSpill, ET_BOOL, "-raLargerGRFOnSpill",
+                "USAGE: -raLargerGRFOnSpill moves a kernel without stack "
+                "calls one step up to the next larger GRF mode, instead of "
+                "spilling, when the first global RA iteration fails",
+                false)
 DEF_VISA_OPTION(vISA_IncSpillCostAllAddrTaken, ET_BOOL, "-allowaddrtakenspill",
                 UNUSED, false)
 DEF_VISA_OPTION(vISA_NewSpillCostFunction, ET_BOOL, "-newspillcost", UNUSED,
@@ -327,6 +339,18 @@ DEF_VISA_OPTION(vISA_DumpLiveRanges, ET_BOOL, "-dumplrs", UNUSED, false)
 DEF_VISA_OPTION(vISA_FailSafeRALimit, ET_INT32, "-failSafeRALimit", UNUSED, 3)
 DEF_VISA_OPTION(vISA_DenseMatrixLimit, ET_INT32, "-denseMatrixLimit", UNUSED,
                 0x800)
+DEF_VISA_OPTION(vISA_TiledMatrixLimit, ET_INT32, "-tiledMatrixLimit",
+                "USAGE: -tiledMatrixLimit <num> builds the interference "
+                "matrix out of 512-bit tiles for kernels with fewer than "
+                "<num> variables but too many for a dense matrix. 0 "
+                "disables the tiled matrix.",
+                0x4000)
+DEF_VISA_OPTION(vISA_LivenessDenseMaxVars, ET_INT32, "-livenessDenseMaxVars",
+                "USAGE: -livenessDenseMaxVars <num> solves liveness on dense "
+                "bit vectors when there are at most <num> variables", 0x800)
+DEF_VISA_OPTION(vISA_LivenessThreads, ET_INT32, "-livenessThreads",
+                "USAGE: -livenessThreads <num> analyzes up to <num> "
+                "subroutines concurrently in inter-procedural liveness", 0)
 DEF_VISA_OPTION(vISA_FillConstOpt, ET_BOOL, "-nofillconstopt", UNUSED, true)
 DEF_VISA_OPTION(vISA_GCRRInFF, ET_BOOL, "-GCRRinFF", UNUSED, false)
 DEF_VISA_OPTION(vISA_IncrementalRA, ET_INT32, "-incrementalra",
@@ -393,6 +417,14 @@ DEF_VISA_OPTION(vISA_LocalSchedulingStartBB, ET_INT32, "-scheduleStartBB",
                 UNUSED, 0)
 DEF_VISA_OPTION(vISA_LocalSchedulingEndBB, ET_INT32, "-scheduleEndBB", UNUSED,
                 UINT_MAX)
+DEF_VISA_OPTION(vISA_LocalSchedulingThreads, ET_INT32, "-scheduleThreads",
+                "USAGE: -scheduleThreads <num> schedules up to <num> basic "
+                "blocks concurrently in local scheduling", 0)
+DEF_VISA_OPTION(vISA_LoopTripCountEstimate, ET_INT32, "-loopTripCountEstimate",
+                "USAGE: -loopTripCountEstimate <num> assumes that every loop "
+                "runs <num> iterations when estimating the cycles per "
+                "work-item of a kernel",
+                16)
 DEF_VISA_OPTION(vISA_assumeL1Hit, ET_BOOL, "-assumeL1Hit", UNUSED, false)
 DEF_VISA_OPTION(vISA_writeCombine, ET_BOOL, "-writeCombine", UNUSED, true)
 DEF_VISA_OPTION(vISA_Q2FInIntegerPipe, ET_BOOL, "-Q2FInteger", UNUSED, false)
@@ -506,6 +538,14 @@ DEF_VISA_OPTION(VISA_AsmFileName, ET_CSTR, "-asmOutput",
                 "USAGE: -asmOutput <FILE>\n", NULL)
 DEF_VISA_OPTION(vISA_DecodeDbg, ET_CSTR, "-decodedbg",
                 "USAGE: -decodedbg <dbg filename>\n", NULL)
+DEF_VISA_OPTION(vISA_ReplayKernels, ET_CSTR, "-replayKernels",
+                "USAGE: -replayKernels <name>[,<name>...] compiles only the "
+                "named kernels of a .isa input\n",
+                NULL)
+DEF_VISA_OPTION(vISA_ReplayThreads, ET_INT32, "-replayThreads",
+                "USAGE: -replayThreads <num> compiles up to <num> kernels of "
+                "a .isa input concurrently\n",
+                0)
 DEF_VISA_OPTION(vISA_DecodeRAMetadata, ET_BOOL_TRUE, "-decodeRAMetadata",
                 "USAGE: decodes a file containing RA metadata and "
                 "outputs it to console in human-readable format", false)
@@ -6,9 +6,11 @@ SPDX-License-Identifier: MIT
 
 ============================= end_copyright_notice ===========================*/
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "Assertions.h"
 #include "BinaryCISAEmission.h"
@@ -21,11 +23,14 @@ SPDX-License-Identifier: MIT
 #include "VISADefines.h"
 #include "VISAKernel.h"
 #include "visa_igc_common_header.h"
+#include "Parallel.h"
 
 
 #include "common/LLVMWarningsPush.hpp"
 #include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 #include "common/LLVMWarningsPop.hpp"
 
@@ -36,10 +41,14 @@ extern bool readIsaBinaryNG(const char *buf, CISA_IR_Builder *builder,
                             std::vector<VISAKernel *> &kernels,
                             const char *kernelName, unsigned int majorVersion,
                             unsigned int minorVersion);
+extern bool readIsaBinaryKernelNamesNG(const char *buf, size_t size,
+                                       std::vector<std::string> &kernelNames);
 
 #ifndef DLL_MODE
 int parseText(llvm::StringRef fileName, int argc, const char *argv[],
               Options &opt);
+int parseBinary(llvm::StringRef fileName, int argc, const char *argv[],
+                Options &opt);
 #endif
 
 #define JIT_SUCCESS 0
@@ -190,7 +199,7 @@ int main(int argc, const char *argv[]) {
   int startPos = 1;
   llvm::StringRef input = argv[1];
   llvm::StringRef ext = llvm::sys::path::extension(input);
-  if (ext == ".visaasm" || ext == ".isaasm") {
+  if (ext == ".visaasm" || ext == ".isaasm" || ext == ".isa") {
     startPos++;
   }
 
@@ -232,7 +241,9 @@ int main(int argc, const char *argv[]) {
     opt.setOptionInternally(VISA_AsmFileName, stem.c_str());
   }
 
-  int err = parseText(input, argc - startPos, &argv[startPos], opt);
+  int err = ext == ".isa"
+                ? parseBinary(input, argc - startPos, &argv[startPos], opt)
+                : parseText(input, argc - startPos, &argv[startPos], opt);
 
 #ifdef COLLECT_ALLOCATION_STATS
 #if 0
@@ -321,4 +332,91 @@ int parseText(llvm::StringRef fileName, int argc, const char *argv[],
   auto dstbErr = CISA_IR_Builder::DestroyBuilder(cisa_builder);
   return dstbErr ? EXIT_FAILURE : EXIT_SUCCESS;
 }
+
+// Compiles kernels of a binary vISA file. The file is memory mapped and only
+// its header is read up front; each kernel selected by -replayKernels (all of
+// them by default) is then decoded into its own builder and compiled, so that
+// picking a few kernels out of a large dump touches only those kernels.
+// With -replayThreads the selected kernels are compiled concurrently, and the
+// timers are reset once before they start: -dumpTimer then reports the times
+// of all the kernels replayed so far.
+int parseBinary(llvm::StringRef fileName, int argc, const char *argv[],
+                Options &opt) {
+  auto bufOrErr = llvm::MemoryBuffer::getFile(fileName);
+  if (!bufOrErr) {
+    std::cerr << fileName.data() << ": cannot open vISA binary file\n";
+    return EXIT_FAILURE;
+  }
+  const llvm::MemoryBuffer &isaBuf = **bufOrErr;
+
+  std::vector<std::string> kernelNames;
+  if (!readIsaBinaryKernelNamesNG(isaBuf.getBufferStart(),
+                                  isaBuf.getBufferSize(), kernelNames)) {
+    std::cerr << fileName.data() << ": malformed vISA binary file\n";
+    return EXIT_FAILURE;
+  }
+
+  if (const char *selected = opt.getOptionCstr(vISA_ReplayKernels)) {
+    llvm::SmallVector<llvm::StringRef, 8> names;
+    llvm::StringRef(selected).split(names, ',', -1, false);
+    std::vector<std::string> selectedNames;
+    for (auto name : names) {
+      if (std::find(kernelNames.begin(), kernelNames.end(), name) ==
+          kernelNames.end()) {
+        std::cerr << fileName.data() << ": no kernel named " << name.str()
+                  << "\n";
+        return EXIT_FAILURE;
+      }
+      selectedNames.push_back(name.str());
+    }
+    kernelNames = std::move(selectedNames);
+  }
+
+  // Each kernel gets its own asm output name, derived from the one of the
+  // input file, so that concurrent compiles do not write the same files.
+  std::vector<std::string> asmNames;
+  for (auto &name : kernelNames)
+    asmNames.push_back(std::string(opt.getOptionCstr(VISA_AsmFileName)) + "_" +
+                       name);
+
+  TARGET_PLATFORM platform =
+      static_cast<TARGET_PLATFORM>(opt.getuInt32Option(vISA_PlatformSet));
+  std::vector<int> results(kernelNames.size(), EXIT_SUCCESS);
+  auto compileKernel = [&](size_t i) {
+    CISA_IR_Builder *cisa_builder = nullptr;
+    if (CISA_IR_Builder::CreateBuilder(cisa_builder, vISA_DEFAULT,
+                                       VISA_BUILDER_BOTH, platform, argc,
+                                       argv)) {
+      results[i] = EXIT_FAILURE;
+      return;
+    }
+    cisa_builder->getOptions()->setOptionInternally(VISA_AsmFileName,
+                                                    asmNames[i].c_str());
+
+    std::vector<VISAKernel *> kernels;
+    if (!readIsaBinaryNG(isaBuf.getBufferStart(), cisa_builder, kernels,
+                         kernelNames[i].c_str(), COMMON_ISA_MAJOR_VER,
+                         COMMON_ISA_MINOR_VER) ||
+        cisa_builder->Compile("")) {
+      std::cerr << kernelNames[i] << ": " << cisa_builder->GetCriticalMsg()
+                << "\n";
+      results[i] = EXIT_FAILURE;
+    }
+    if (CISA_IR_Builder::DestroyBuilder(cisa_builder))
+      results[i] = EXIT_FAILURE;
+  };
+
+  unsigned numThreads = opt.getuInt32Option(vISA_ReplayThreads);
+  if (numThreads > 1)
+    holdTimers();
+  vISA::parallelFor(numThreads, kernelNames.size(), compileKernel);
+  if (numThreads > 1)
+    releaseTimers();
+
+  for (int result : results) {
+    if (result != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
 #endif